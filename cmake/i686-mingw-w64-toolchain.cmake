@@ -1,7 +1,12 @@
 set(CMAKE_SYSTEM_NAME Windows)
 
-set(CMAKE_C_COMPILER i686-w64-mingw32-gcc)
-set(CMAKE_CXX_COMPILER i686-w64-mingw32-g++)
+# Appended to the compiler names, e.g. -posix to pick the posix thread model variants where
+# the default ones lack std::thread.
+set(MINGW_COMPILER_SUFFIX "" CACHE STRING "Suffix of the MinGW compilers to use, e.g. -posix")
+list(APPEND CMAKE_TRY_COMPILE_PLATFORM_VARIABLES MINGW_COMPILER_SUFFIX)
+
+set(CMAKE_C_COMPILER i686-w64-mingw32-gcc${MINGW_COMPILER_SUFFIX})
+set(CMAKE_CXX_COMPILER i686-w64-mingw32-g++${MINGW_COMPILER_SUFFIX})
 set(CMAKE_RC_COMPILER i686-w64-mingw32-windres)
 set(CMAKE_RC_FLAGS -DGCC_WINDRES)
 
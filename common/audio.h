@@ -115,6 +115,18 @@ typedef enum
     SFX_LAST
 } SFX_Type;
 
+/*=========================================================================*/
+/* Statistics for the decoded sample cache kept by the audio backend.			*/
+/*=========================================================================*/
+typedef struct
+{
+    unsigned Hits;               // Plays served from an already decoded sample.
+    unsigned Misses;             // Plays that had to decode the sample.
+    unsigned Evictions;          // Entries dropped to make room for others.
+    unsigned Entries;            // Samples currently resident.
+    unsigned long ResidentBytes; // Decoded PCM bytes currently resident.
+} SampleCacheStatsType;
+
 /*=========================================================================*/
 /* The following prototypes are for the file: SOUNDIO.CPP						*/
 /*=========================================================================*/
@@ -144,6 +156,7 @@ void Restore_Sound_Buffers(void);
 bool Set_Primary_Buffer_Format(void);
 bool Start_Primary_Sound_Buffer(bool forced);
 void Stop_Primary_Sound_Buffer(void);
+void Get_Sample_Cache_Stats(SampleCacheStatsType* stats);
 
 /*
 ** Function to call if we detect focus loss
@@ -30,6 +30,8 @@
  *   Char_Pixel_Width -- Return pixel width of a character.                *
  *   String_Pixel_Width -- Return pixel width of a string of characters.   *
  *   Get_Next_Text_Print_XY -- Calculates X and Y given ret value from Text_P*
+ *   Glyph_Atlas -- Finds the glyph cache for the current font and colors. *
+ *   Glyph_Fetch -- Returns a character's glyph, drawing it out if needed. *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "font.h"
@@ -37,9 +39,11 @@
 #include "gbuffer.h"
 #include "file.h"
 #include "memflag.h"
+#include "stamprow.h"
 
 #include <errno.h>
 #include <string.h>
+#include <vector>
 
 int FontXSpacing = 0;
 int FontYSpacing = 0;
@@ -302,6 +306,168 @@ struct FontHeader
     unsigned char MaxWidth;           // Max char width
 };
 #pragma pack(pop)
+
+/*
+**	Characters of one font drawn out in the colors of one palette range, a byte per
+**	pixel, with 0 wherever Buffer_Print leaves the destination alone. Glyphs are made
+**	the first time they are printed, after which printing one is a copy of the rows
+**	that hold anything.
+*/
+#define GLYPH_ATLAS_COUNT 16
+
+struct GlyphType
+{
+    int Offset;            // into Pixels, or -1 if the glyph hasn't been drawn out yet
+    unsigned char Rows;    // rows from the top of the character cell
+    unsigned char Top;     // first row with anything to draw
+    unsigned char Bottom;  // one past the last row with anything to draw
+};
+
+struct GlyphAtlasType
+{
+    void const* Font;
+    FontHeader Header;     // to notice a different font loaded at the same address
+    unsigned char Colors[16];
+    unsigned long LastUsed;
+    GlyphType Glyphs[256];
+    std::vector<unsigned char> Pixels;
+};
+
+static GlyphAtlasType GlyphAtlas[GLYPH_ATLAS_COUNT];
+static unsigned long GlyphAtlasClock;
+
+static bool Row_Is_Clear(unsigned char const* row, int width)
+{
+    for (int i = 0; i < width; i++) {
+        if (row[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/***************************************************************************
+ * GLYPH_ATLAS -- Finds the glyph cache for the current font and colors.   *
+ *                                                                         *
+ *    The least recently used cache is emptied for the combination if      *
+ *    none holds it yet.                                                   *
+ *                                                                         *
+ * INPUT:   colors   -- The font color translation row in use.            *
+ *                                                                         *
+ * OUTPUT:  Returns with the glyph cache to print from.                    *
+ *                                                                         *
+ * WARNINGS:   Set_Font must have been called first.                       *
+ *=========================================================================*/
+static GlyphAtlasType* Glyph_Atlas(unsigned char const* colors)
+{
+    const FontHeader* header = reinterpret_cast<const FontHeader*>(FontPtr);
+    GlyphAtlasType* atlas = &GlyphAtlas[0];
+
+    GlyphAtlasClock++;
+    for (int i = 0; i < GLYPH_ATLAS_COUNT; i++) {
+        GlyphAtlasType* entry = &GlyphAtlas[i];
+
+        if (entry->Font == FontPtr && memcmp(&entry->Header, header, sizeof(FontHeader)) == 0
+            && memcmp(entry->Colors, colors, sizeof(entry->Colors)) == 0) {
+            entry->LastUsed = GlyphAtlasClock;
+            return entry;
+        }
+
+        if (entry->LastUsed < atlas->LastUsed) {
+            atlas = entry;
+        }
+    }
+
+    atlas->Font = FontPtr;
+    atlas->Header = *header;
+    memcpy(atlas->Colors, colors, sizeof(atlas->Colors));
+    atlas->LastUsed = GlyphAtlasClock;
+    for (int i = 0; i < 256; i++) {
+        atlas->Glyphs[i].Offset = -1;
+    }
+    atlas->Pixels.clear();
+
+    return atlas;
+}
+
+/***************************************************************************
+ * GLYPH_FETCH -- Returns a character's glyph, drawing it out if needed.   *
+ *                                                                         *
+ *    The 4 bit font data is expanded through the atlas colors exactly as  *
+ *    Buffer_Print used to plot it: the lines above the character data     *
+ *    take the background color, and so do the lines below it unless the   *
+ *    character has no data at all.                                        *
+ *                                                                         *
+ * INPUT:   atlas    -- The glyph cache for the font and colors.           *
+ *                                                                         *
+ *          char_num -- The character wanted.                              *
+ *                                                                         *
+ * OUTPUT:  Returns with the glyph.                                        *
+ *                                                                         *
+ * WARNINGS:   none                                                        *
+ *=========================================================================*/
+static GlyphType const& Glyph_Fetch(GlyphAtlasType* atlas, unsigned char char_num)
+{
+    GlyphType& glyph = atlas->Glyphs[char_num];
+
+    if (glyph.Offset >= 0) {
+        return glyph;
+    }
+
+    const FontHeader* fntheader = reinterpret_cast<const FontHeader*>(FontPtr);
+    const unsigned short* datalist =
+        reinterpret_cast<const unsigned short*>(reinterpret_cast<const char*>(FontPtr) + fntheader->OffsetBlockOffset);
+    const unsigned char* widthlist = reinterpret_cast<const unsigned char*>(FontPtr) + fntheader->WidthBlockOffset;
+    const unsigned short* linelist =
+        reinterpret_cast<const unsigned short*>(reinterpret_cast<const char*>(FontPtr) + fntheader->HeightOffset);
+
+    const unsigned char* char_data = reinterpret_cast<const unsigned char*>(FontPtr) + datalist[char_num];
+    int width = widthlist[char_num];
+    int char_ypos = linelist[char_num] & 0xFF;
+    int char_lines = linelist[char_num] >> 8;
+    int rows = char_ypos + char_lines;
+
+    /*
+    **	Rows below the character data are only filled for characters that have some.
+    */
+    if (char_lines && rows < fntheader->MaxHeight) {
+        rows = fntheader->MaxHeight;
+    }
+
+    glyph.Offset = int(atlas->Pixels.size());
+    glyph.Rows = (unsigned char)rows;
+    atlas->Pixels.resize(glyph.Offset + width * rows, atlas->Colors[0]);
+    unsigned char* pixels = atlas->Pixels.data() + glyph.Offset;
+
+    unsigned char* dst = pixels + char_ypos * width;
+    for (int i = 0; i < char_lines; ++i) {
+        for (int j = 0; j < width; j += 2) {
+            unsigned char color_packed = *char_data++;
+
+            *dst++ = atlas->Colors[color_packed & 0x0F];
+            if (j + 1 < width) {
+                *dst++ = atlas->Colors[color_packed >> 4];
+            }
+        }
+    }
+
+    /*
+    **	Rows that leave the destination alone at the top and bottom needn't be visited.
+    */
+    int top = 0;
+    int bottom = rows;
+    while (top < bottom && Row_Is_Clear(pixels + top * width, width)) {
+        top++;
+    }
+    while (bottom > top && Row_Is_Clear(pixels + (bottom - 1) * width, width)) {
+        bottom--;
+    }
+    glyph.Top = (unsigned char)top;
+    glyph.Bottom = (unsigned char)bottom;
+
+    return glyph;
+}
+
 /***************************************************************************
  * Buffer_Print -- C++ text print to graphic buffer routine                *
  *                                                                         *
@@ -330,11 +496,7 @@ long Buffer_Print(void* thisptr, const char* string, int x, int y, int fground,
     int base_x = x;
 
     if (FontPtr != nullptr) {
-        const unsigned short* datalist = reinterpret_cast<const unsigned short*>(reinterpret_cast<const char*>(FontPtr)
-                                                                                 + fntheader->OffsetBlockOffset);
         const unsigned char* widthlist = reinterpret_cast<const unsigned char*>(FontPtr) + fntheader->WidthBlockOffset;
-        const unsigned short* linelist =
-            reinterpret_cast<const unsigned short*>(reinterpret_cast<const char*>(FontPtr) + fntheader->HeightOffset);
 
         int fntheight = fntheader->MaxHeight;
         int ydisplace = FontYSpacing + fntheight;
@@ -345,6 +507,7 @@ long Buffer_Print(void* thisptr, const char* string, int x, int y, int fground,
             // Set colors to draw with
             ColorXlat[0][1] = fground;
             ColorXlat[0][0] = bground;
+            GlyphAtlasType* atlas = Glyph_Atlas(ColorXlat[0]);
 
             while (true) {
                 // Handle a new line
@@ -401,74 +564,16 @@ long Buffer_Print(void* thisptr, const char* string, int x, int y, int fground,
                     continue;
                 }
 
-                // Prepare variables for drawing
+                // Draw the character from its glyph, leaving out the rows with nothing to draw
                 x += FontXSpacing + char_width;
-                int next_line = pitch - char_width;
-                const unsigned char* char_data = reinterpret_cast<const unsigned char*>(FontPtr) + datalist[char_num];
-                int char_lle = linelist[char_num];
-                int char_ypos = char_lle & 0xFF;
-                int char_lines = char_lle >> 8;
-                int char_height = fntheight - (char_ypos + char_lines);
-                int blit_width = widthlist[char_num];
-
-                // Fill unused lines if we have a color other than 0
-                if (char_ypos) {
-                    unsigned char color = ColorXlat[0][0];
-                    if (color) {
-                        for (int i = char_ypos; i; --i) {
-                            memset(char_dst, color, blit_width);
-                            char_dst += pitch;
-                        }
-                    } else {
-                        char_dst += pitch * char_ypos;
-                    }
-                }
-
-                // Draw the character
-                if (char_lines) {
-                    for (int i = 0; i < char_lines; ++i) {
-                        int width_todraw = blit_width;
-
-                        while (width_todraw) {
-                            unsigned char color_packed;
-                            color_packed = *char_data++;
-                            unsigned char color = ColorXlat[0][color_packed & 0x0F];
-
-                            if (color) {
-                                *char_dst = color;
-                            }
-
-                            ++char_dst;
-                            --width_todraw;
-
-                            if (width_todraw == 0) {
-                                break;
-                            }
-
-                            color = ColorXlat[0][color_packed >> 4];
-
-                            if (color) {
-                                *char_dst = color;
-                            }
-
-                            ++char_dst;
-                            --width_todraw;
-                        }
-
-                        char_dst += next_line;
-                    }
-
-                    // Fill any remaining unused lines.
-                    if (char_height) {
-                        unsigned char color = ColorXlat[0][0];
-
-                        if (color) {
-                            for (int i = char_height; i; --i) {
-                                memset(char_dst, color, blit_width);
-                                char_dst += pitch;
-                            }
-                        }
-                    }
+                GlyphType const& glyph = Glyph_Fetch(atlas, char_num);
+                const unsigned char* char_data = atlas->Pixels.data() + glyph.Offset + glyph.Top * char_width;
+
+                char_dst += glyph.Top * pitch;
+                for (int i = glyph.Top; i < glyph.Bottom; ++i) {
+                    Stamp_Trans_Row(char_dst, char_data, char_width);
+                    char_dst += pitch;
+                    char_data += char_width;
                 }
             }
         }
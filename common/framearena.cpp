@@ -0,0 +1,136 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "framearena.h"
+#include <assert.h>
+#include <stdlib.h>
+
+#define CHUNK_HEADER_SIZE ((sizeof(ChunkType) + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1))
+
+FrameArenaClass::FrameArenaClass(size_t size)
+    : Buffer((char*)malloc(size))
+    , BufferSize(Buffer != nullptr ? size : 0)
+    , Used(0)
+    , Total(0)
+    , Chunks(nullptr)
+    , HighWater(0)
+    , OverflowCount(0)
+    , Peak(0)
+    , Resets(0)
+{
+}
+
+FrameArenaClass::~FrameArenaClass()
+{
+    Rewind(0);
+    free(Buffer);
+}
+
+/*
+**	The arena of the calling thread. The game thread resets its own at the end
+**	of every frame; any other thread using one must rewind or reset it itself.
+*/
+FrameArenaClass& FrameArenaClass::Thread(void)
+{
+    static thread_local FrameArenaClass arena;
+    return arena;
+}
+
+/*
+**	Returns memory aligned to ALIGNMENT, or NULL only if the heap is exhausted.
+*/
+void* FrameArenaClass::Alloc(size_t size)
+{
+    void* ptr;
+
+    size = (size + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+
+    /*
+    **	Once anything has spilled to the heap, later requests follow it, so that
+    **	the total in use only ever grows between rewinds.
+    */
+    if (Chunks == nullptr && size <= BufferSize - Used) {
+        ptr = Buffer + Used;
+        Used += size;
+    } else {
+        ChunkType* chunk = (ChunkType*)malloc(CHUNK_HEADER_SIZE + size);
+        if (chunk == nullptr) {
+            return (nullptr);
+        }
+        chunk->Next = Chunks;
+        chunk->Start = Total;
+        Chunks = chunk;
+        OverflowCount++;
+        ptr = (char*)chunk + CHUNK_HEADER_SIZE;
+    }
+
+    Total += size;
+    if (Total > HighWater) {
+        HighWater = Total;
+    }
+    if (Total > Peak) {
+        Peak = Total;
+    }
+    return (ptr);
+}
+
+void FrameArenaClass::Rewind(size_t mark)
+{
+    assert(mark <= Total);
+
+    while (Chunks != nullptr && Chunks->Start >= mark) {
+        ChunkType* chunk = Chunks;
+        Chunks = chunk->Next;
+        free(chunk);
+    }
+
+    if (Chunks == nullptr) {
+        Used = mark;
+    }
+    Total = mark;
+
+    /*
+    **	With nothing in use the buffer can be replaced by one big enough for
+    **	the most that has been needed lately.
+    */
+    if (Total == 0 && Peak > BufferSize && BufferSize < MAX_SIZE) {
+        Resize(Peak < MAX_SIZE ? Peak : (size_t)MAX_SIZE);
+    }
+}
+
+void FrameArenaClass::Reset(void)
+{
+    Rewind(0);
+
+    if (++Resets < TRIM_RESETS) {
+        return;
+    }
+
+    if (BufferSize > DEFAULT_SIZE && Peak <= BufferSize / 4) {
+        size_t size = Peak * 2;
+        Resize(size > DEFAULT_SIZE ? size : (size_t)DEFAULT_SIZE);
+    }
+    Peak = 0;
+    Resets = 0;
+}
+
+void FrameArenaClass::Resize(size_t size)
+{
+    assert(Total == 0);
+
+    char* buffer = (char*)malloc(size);
+    if (buffer != nullptr) {
+        free(Buffer);
+        Buffer = buffer;
+        BufferSize = size;
+        Used = 0;
+    }
+}
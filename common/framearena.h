@@ -0,0 +1,99 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <stddef.h>
+
+/*
+**	Linear allocator for memory that is only needed for a moment. Allocation
+**	bumps a pointer and nothing is freed singly; instead the arena is rewound to
+**	a mark taken earlier, or reset entirely at the end of each game frame.
+**
+**	Requests that don't fit spill over into heap blocks, freed on the rewind.
+**	The highest total in use is remembered and the arena grows to it the next
+**	time it is empty, up to MAX_SIZE, so it settles at the size the game
+**	actually needs. If a whole TRIM_RESETS resets go by using no more than a
+**	quarter of a grown arena, it shrinks back to twice what they did use, so
+**	one unusually large request doesn't keep its memory for good.
+*/
+class FrameArenaClass
+{
+public:
+    enum
+    {
+        DEFAULT_SIZE = 64 * 1024,
+        MAX_SIZE = 1024 * 1024, // Largest the arena grows to, bigger totals keep spilling.
+        TRIM_RESETS = 256,      // Resets between checks for shrinking the arena.
+        ALIGNMENT = 16
+    };
+
+    FrameArenaClass(size_t size = DEFAULT_SIZE);
+    ~FrameArenaClass();
+
+    void* Alloc(size_t size);
+
+    /*
+    **	A mark is the amount in use; rewinding to it frees everything allocated
+    **	since it was taken.
+    */
+    size_t Mark(void) const
+    {
+        return (Total);
+    }
+    void Rewind(size_t mark);
+    void Reset(void);
+
+    size_t Size(void) const
+    {
+        return (BufferSize);
+    }
+    size_t High_Water(void) const
+    {
+        return (HighWater);
+    }
+    unsigned long Overflows(void) const
+    {
+        return (OverflowCount);
+    }
+
+    static FrameArenaClass& Thread(void);
+
+private:
+    FrameArenaClass(FrameArenaClass const&);
+    FrameArenaClass& operator=(FrameArenaClass const&);
+
+    void Resize(size_t size);
+
+    /*
+    **	Header of a heap block holding one request that didn't fit. Start is the
+    **	total in use when it was made.
+    */
+    typedef struct ChunkStruct
+    {
+        struct ChunkStruct* Next;
+        size_t Start;
+    } ChunkType;
+
+    char* Buffer;
+    size_t BufferSize;
+    size_t Used;       // bytes of Buffer handed out
+    size_t Total;      // Used plus the size of every overflow chunk
+    ChunkType* Chunks; // overflow chunks, newest first
+    size_t HighWater;
+    unsigned long OverflowCount;
+    size_t Peak;       // most in use since the last check for shrinking
+    unsigned Resets;   // resets since the last check for shrinking
+
+};
+
+#endif
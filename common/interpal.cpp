@@ -165,8 +165,12 @@ void Create_Palette_Interpolation_Table(void)
         first_b = *first_palette_ptr;
         first_palette_ptr++;
 
-        second_palette_ptr = (unsigned char*)InterpolationPalette;
-        for (j = 0; j < SIZE_OF_PALETTE; j++) {
+        //
+        // The halfway colour of i and j is the same as that of j and i, so only
+        // half the table needs searching.
+        //
+        second_palette_ptr = (unsigned char*)InterpolationPalette + i * 3;
+        for (j = i; j < SIZE_OF_PALETTE; j++) {
             //
             // Get the second palette entry's RGB.
             //
@@ -207,6 +211,7 @@ void Create_Palette_Interpolation_Table(void)
             }
 
             PaletteInterpolationTable[i][j] = (unsigned char)index_of_closest_color;
+            PaletteInterpolationTable[j][i] = (unsigned char)index_of_closest_color;
         }
     }
 
@@ -0,0 +1,359 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "jobs.h"
+#include <assert.h>
+#include <algorithm>
+
+/*
+**	The pool a worker thread belongs to and its index in it. Threads outside any
+**	pool have no system and use index 0.
+*/
+static thread_local JobSystemClass* CurrentSystem = nullptr;
+static thread_local int CurrentIndex = 0;
+
+typedef struct
+{
+    JobSystemClass::RangeFuncType Func;
+    void* Data;
+    int Last;
+    int Grain;
+    std::atomic<int> Next;
+    JobSystemClass* System;
+} RangeJobType;
+
+JobSystemClass::JobSystemClass(int workers, size_t scratch_size)
+    : WorkerCount(workers)
+    , IsSerial(false)
+    , Queued(0)
+    , Outstanding(0)
+    , IsQuitting(false)
+{
+    if (WorkerCount < 0) {
+        WorkerCount = std::max((int)std::thread::hardware_concurrency() - 1, 0);
+    }
+
+    Queues = new QueueType[WorkerCount + 1];
+    Scratch = new ScratchType[WorkerCount + 1];
+    for (int i = 0; i <= WorkerCount; i++) {
+        Scratch[i].Buffer = new char[scratch_size];
+        Scratch[i].Size = scratch_size;
+        Scratch[i].Used = 0;
+    }
+
+    for (int i = 1; i <= WorkerCount; i++) {
+        Threads.push_back(std::thread(&JobSystemClass::Worker_Loop, this, i));
+    }
+}
+
+JobSystemClass::~JobSystemClass()
+{
+    Wait_All();
+
+    {
+        std::lock_guard<std::mutex> lock(SleepLock);
+        IsQuitting = true;
+    }
+    Wake.notify_all();
+    for (size_t i = 0; i < Threads.size(); i++) {
+        Threads[i].join();
+    }
+
+    for (int i = 0; i <= WorkerCount; i++) {
+        delete[] Scratch[i].Buffer;
+    }
+    delete[] Scratch;
+    delete[] Queues;
+}
+
+/*
+**	The pool shared by the engine, with a worker for every core but the one the
+**	game runs on.
+*/
+JobSystemClass& JobSystemClass::Shared(void)
+{
+    static JobSystemClass system;
+    return system;
+}
+
+int JobSystemClass::Thread_Index(void) const
+{
+    return (CurrentSystem == this ? CurrentIndex : 0);
+}
+
+/*
+**	Finishes everything already submitted before switching, so no job started
+**	in one mode is still running in the other.
+*/
+void JobSystemClass::Set_Serial(bool serial)
+{
+    Wait_All();
+    IsSerial = serial;
+}
+
+/*
+**	Queues a job to run once every job in depends has finished. The returned
+**	handle must later be passed to Wait or Release.
+*/
+JobClass* JobSystemClass::Submit(JobFuncType func, void* data, JobClass* const* depends, int count)
+{
+    JobClass* job = new JobClass;
+    job->Func = func;
+    job->Data = data;
+    job->Unfinished = 1;
+    job->RefCount = 2;
+    job->IsDone = false;
+    Outstanding++;
+
+    if (IsSerial) {
+        for (int i = 0; i < count; i++) {
+            assert(depends[i]->Is_Done());
+        }
+        Run_Job(job);
+        return (job);
+    }
+
+    for (int i = 0; i < count; i++) {
+        JobClass* dep = depends[i];
+        std::lock_guard<std::mutex> lock(dep->Lock);
+        if (!dep->Is_Done()) {
+            dep->Dependents.push_back(job);
+            job->Unfinished++;
+        }
+    }
+
+    if (--job->Unfinished == 0) {
+        Enqueue(job);
+    }
+    return (job);
+}
+
+/*
+**	Runs other jobs on this thread until the job is done, then releases it.
+*/
+void JobSystemClass::Wait(JobClass* job)
+{
+    while (!job->Is_Done()) {
+        if (!Help()) {
+            std::this_thread::yield();
+        }
+    }
+    Release(job);
+}
+
+void JobSystemClass::Release(JobClass* job)
+{
+    if (--job->RefCount == 0) {
+        delete job;
+    }
+}
+
+/*
+**	Runs jobs until none are left. A job must not call this, since it would be
+**	waiting on itself.
+*/
+void JobSystemClass::Wait_All(void)
+{
+    while (Outstanding > 0) {
+        if (!Help()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/*
+**	Calls func over [first, last) in chunks of grain indices. The calling thread
+**	takes chunks along with the workers and returns when all are done.
+*/
+void JobSystemClass::Parallel_For(int first, int last, int grain, RangeFuncType func, void* data)
+{
+    if (last <= first) {
+        return;
+    }
+    grain = std::max(grain, 1);
+
+    int chunks = (last - first + grain - 1) / grain;
+    int runners = std::min(WorkerCount, chunks - 1);
+
+    RangeJobType range;
+    range.Func = func;
+    range.Data = data;
+    range.Last = last;
+    range.Grain = grain;
+    range.Next = first;
+    range.System = this;
+
+    if (IsSerial || runners <= 0) {
+        Run_Range(&range);
+        return;
+    }
+
+    std::vector<JobClass*> jobs(runners);
+    for (int i = 0; i < runners; i++) {
+        jobs[i] = Submit(Run_Range, &range);
+    }
+    Run_Range(&range);
+    for (int i = 0; i < runners; i++) {
+        Wait(jobs[i]);
+    }
+}
+
+/*
+**	Hands out memory that lasts until the job (or Parallel_For chunk) running on
+**	this thread returns. Returns NULL when the thread's scratch space is used up.
+**	Threads outside the pool all share one scratch area, so only one of them
+**	may use it at a time.
+*/
+void* JobSystemClass::Scratch_Alloc(size_t size)
+{
+    ScratchType& scratch = Thread_Scratch();
+
+    size = (size + 15) & ~(size_t)15;
+    if (size > scratch.Size - scratch.Used) {
+        return (nullptr);
+    }
+
+    void* ptr = scratch.Buffer + scratch.Used;
+    scratch.Used += size;
+    return (ptr);
+}
+
+JobSystemClass::ScratchType& JobSystemClass::Thread_Scratch(void)
+{
+    return (Scratch[Thread_Index()]);
+}
+
+void JobSystemClass::Worker_Loop(int index)
+{
+    CurrentSystem = this;
+    CurrentIndex = index;
+
+    for (;;) {
+        JobClass* job = Take_Job(index);
+        if (job != nullptr) {
+            Run_Job(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(SleepLock);
+        Wake.wait(lock, [this] { return (Queued > 0 || IsQuitting); });
+        if (IsQuitting && Queued == 0) {
+            break;
+        }
+    }
+}
+
+/*
+**	Jobs go on the queue of the thread that made them ready, so a worker keeps
+**	the jobs it spawns unless another thread runs out and steals them.
+*/
+void JobSystemClass::Enqueue(JobClass* job)
+{
+    QueueType& queue = Queues[Thread_Index()];
+    {
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        queue.Jobs.push_back(job);
+    }
+    Queued++;
+
+    {
+        std::lock_guard<std::mutex> lock(SleepLock);
+    }
+    Wake.notify_one();
+}
+
+/*
+**	Takes the newest job from the thread's own queue, or failing that the oldest
+**	from another queue.
+*/
+JobClass* JobSystemClass::Take_Job(int index)
+{
+    JobClass* job = nullptr;
+
+    for (int i = 0; i <= WorkerCount && job == nullptr; i++) {
+        QueueType& queue = Queues[(index + i) % (WorkerCount + 1)];
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        if (!queue.Jobs.empty()) {
+            if (i == 0) {
+                job = queue.Jobs.back();
+                queue.Jobs.pop_back();
+            } else {
+                job = queue.Jobs.front();
+                queue.Jobs.pop_front();
+            }
+        }
+    }
+
+    if (job != nullptr) {
+        Queued--;
+    }
+    return (job);
+}
+
+bool JobSystemClass::Help(void)
+{
+    JobClass* job = Take_Job(Thread_Index());
+    if (job == nullptr) {
+        return (false);
+    }
+    Run_Job(job);
+    return (true);
+}
+
+void JobSystemClass::Run_Job(JobClass* job)
+{
+    ScratchType& scratch = Thread_Scratch();
+    size_t used = scratch.Used;
+
+    job->Func(job->Data);
+
+    scratch.Used = used;
+    Finish_Job(job);
+}
+
+/*
+**	Marks the job done and queues any jobs that were only waiting on it.
+*/
+void JobSystemClass::Finish_Job(JobClass* job)
+{
+    std::vector<JobClass*> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->Lock);
+        job->IsDone.store(true, std::memory_order_release);
+        dependents.swap(job->Dependents);
+    }
+
+    for (size_t i = 0; i < dependents.size(); i++) {
+        if (--dependents[i]->Unfinished == 0) {
+            Enqueue(dependents[i]);
+        }
+    }
+
+    Outstanding--;
+    Release(job);
+}
+
+void JobSystemClass::Run_Range(void* data)
+{
+    RangeJobType* range = (RangeJobType*)data;
+    ScratchType& scratch = range->System->Thread_Scratch();
+
+    for (;;) {
+        int first = range->Next.fetch_add(range->Grain);
+        if (first >= range->Last) {
+            break;
+        }
+
+        size_t used = scratch.Used;
+        range->Func(range->Data, first, std::min(first + range->Grain, range->Last));
+        scratch.Used = used;
+    }
+}
@@ -0,0 +1,143 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystemClass;
+
+/*
+**	One unit of work queued on a JobSystemClass. Jobs are only ever handled
+**	through the pointer Submit returns, which stays valid until it is passed
+**	to Wait or Release.
+*/
+class JobClass
+{
+public:
+    bool Is_Done(void) const
+    {
+        return (IsDone.load(std::memory_order_acquire));
+    }
+
+private:
+    friend class JobSystemClass;
+
+    void (*Func)(void* data);
+    void* Data;
+
+    std::atomic<int> Unfinished; // dependencies still to finish, plus one until queued
+    std::atomic<int> RefCount;   // the system while running, plus the handle
+    std::atomic<bool> IsDone;
+
+    std::mutex Lock; // guards Dependents against the job finishing
+    std::vector<JobClass*> Dependents;
+};
+
+/*
+**	A fixed pool of worker threads. Each worker takes jobs from the back of its
+**	own queue and, when that is empty, steals from the front of the others.
+**	Threads that wait on a job run queued jobs until it is done, so jobs may
+**	submit and wait on other jobs.
+**
+**	In serial mode every job runs on the submitting thread the moment it is
+**	submitted, and Parallel_For runs its chunks in order. Work is split in the
+**	same places either way, which makes it the mode to run in when a result
+**	differs from run to run.
+*/
+class JobSystemClass
+{
+public:
+    typedef void (*JobFuncType)(void* data);
+    typedef void (*RangeFuncType)(void* data, int first, int last);
+
+    enum
+    {
+        DEFAULT_SCRATCH_SIZE = 256 * 1024 // bytes of scratch space per thread
+    };
+
+    JobSystemClass(int workers = -1, size_t scratch_size = DEFAULT_SCRATCH_SIZE);
+    ~JobSystemClass();
+
+    /*
+    **	Worker threads, not counting the threads that submit work.
+    */
+    int Workers(void) const
+    {
+        return (WorkerCount);
+    }
+
+    void Set_Serial(bool serial);
+    bool Is_Serial(void) const
+    {
+        return (IsSerial);
+    }
+
+    JobClass* Submit(JobFuncType func, void* data, JobClass* const* depends = NULL, int count = 0);
+    void Wait(JobClass* job);
+    void Release(JobClass* job);
+    void Wait_All(void);
+
+    void Parallel_For(int first, int last, int grain, RangeFuncType func, void* data);
+
+    void* Scratch_Alloc(size_t size);
+
+    int Thread_Index(void) const;
+    static JobSystemClass& Shared(void);
+
+private:
+    typedef struct
+    {
+        std::mutex Lock;
+        std::deque<JobClass*> Jobs;
+    } QueueType;
+
+    /*
+    **	Bump allocator reset as each job finishes. Index 0 belongs to threads
+    **	outside the pool, the rest to the workers in order.
+    */
+    typedef struct
+    {
+        char* Buffer;
+        size_t Size;
+        size_t Used;
+    } ScratchType;
+
+    void Worker_Loop(int index);
+    void Enqueue(JobClass* job);
+    JobClass* Take_Job(int index);
+    void Run_Job(JobClass* job);
+    void Finish_Job(JobClass* job);
+    bool Help(void);
+    ScratchType& Thread_Scratch(void);
+    static void Run_Range(void* data);
+
+    int WorkerCount;
+    bool IsSerial;
+    std::vector<std::thread> Threads;
+    QueueType* Queues;
+    ScratchType* Scratch;
+
+    std::atomic<int> Queued;      // jobs sitting in a queue
+    std::atomic<int> Outstanding; // jobs submitted and not yet finished
+    std::atomic<bool> IsQuitting;
+    std::mutex SleepLock;
+    std::condition_variable Wake;
+};
+
+#endif
@@ -0,0 +1,95 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "palconv.h"
+#include "jobs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PALCONV_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define PALCONV_NEON
+#endif
+
+/*
+**	Outputs smaller than this many pixels are converted on the calling thread,
+**	handing them to the job system would cost more than it saves.
+*/
+#define PALCONV_THREAD_PIXELS (1024 * 1024)
+#define PALCONV_STRIPE_ROWS   32
+
+typedef struct
+{
+    uint8_t* Dst;
+    int DstPitch;
+    uint8_t const* Src;
+    int SrcPitch;
+    int Width;
+    uint32_t const* LUT;
+} PalConvType;
+
+/*
+**	Runs func over source rows [0, rows), split into stripes across the shared
+**	job system when the output is large enough to be worth it.
+*/
+static void Run_Stripes(JobSystemClass::RangeFuncType func, PalConvType* conv, int rows, long pixels)
+{
+    if (pixels < PALCONV_THREAD_PIXELS) {
+        func(conv, 0, rows);
+        return;
+    }
+
+    JobSystemClass::Shared().Parallel_For(0, rows, PALCONV_STRIPE_ROWS, func, conv);
+}
+
+/*
+**	There is no gather below AVX2, so the lookups themselves stay scalar; four
+**	results are packed into a register and written with one store.
+*/
+static inline void Expand_Row(uint32_t* dst, uint8_t const* src, int width, uint32_t const* lut)
+{
+    int i = 0;
+
+#if defined(PALCONV_SSE2)
+    for (; i + 4 <= width; i += 4) {
+        __m128i v = _mm_set_epi32(lut[src[i + 3]], lut[src[i + 2]], lut[src[i + 1]], lut[src[i]]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+#elif defined(PALCONV_NEON)
+    for (; i + 4 <= width; i += 4) {
+        uint32_t v[4] = {lut[src[i]], lut[src[i + 1]], lut[src[i + 2]], lut[src[i + 3]]};
+        vst1q_u32(dst + i, vld1q_u32(v));
+    }
+#endif
+
+    for (; i < width; i++) {
+        dst[i] = lut[src[i]];
+    }
+}
+
+static void Expand_Stripe(void* data, int first, int last)
+{
+    PalConvType const* conv = (PalConvType const*)data;
+    for (int y = first; y < last; y++) {
+        Expand_Row((uint32_t*)(conv->Dst + y * conv->DstPitch), conv->Src + y * conv->SrcPitch, conv->Width, conv->LUT);
+    }
+}
+
+void Palette_Expand(void* dst, int dst_pitch, void const* src, int src_pitch, int width, int height, uint32_t const* lut)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    PalConvType conv = {(uint8_t*)dst, dst_pitch, (uint8_t const*)src, src_pitch, width, lut};
+    Run_Stripes(Expand_Stripe, &conv, height, (long)width * height);
+}
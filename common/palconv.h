@@ -0,0 +1,30 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef PALCONV_H
+#define PALCONV_H
+
+#include <stdint.h>
+
+/*
+**	Converts 8 bit paletted pixels to 32 bit pixels through a 256 entry table that
+**	already holds each palette colour in the output format. Pitches are in bytes.
+**	Large outputs are split into horizontal stripes converted on several threads.
+*/
+void Palette_Expand(void* dst,
+                    int dst_pitch,
+                    void const* src,
+                    int src_pitch,
+                    int width,
+                    int height,
+                    uint32_t const* lut);
+
+#endif
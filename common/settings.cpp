@@ -28,6 +28,11 @@ SettingsClass::SettingsClass()
     Video.Scaler = "nearest";
     Video.Driver = "default";
     Video.PixelFormat = "default";
+
+    /*
+    ** Telemetry settings
+    */
+    Telemetry.File = "";
 }
 
 void SettingsClass::Load(INIClass& ini)
@@ -59,6 +64,11 @@ void SettingsClass::Load(INIClass& ini)
     */
     Video.InterpolationMode = Bound(ini.Get_Int("Video", "InterpolationMode", Video.InterpolationMode), 0, 2);
 
+    /*
+    ** Per frame statistics are written to this file when it is set, as CSV or as JSON lines for .json and .jsonl.
+    */
+    Telemetry.File = ini.Get_String("Telemetry", "File", Telemetry.File);
+
     /*
     ** Boxing and raw input require software cursor.
     */
@@ -95,4 +105,11 @@ void SettingsClass::Save(INIClass& ini)
     ** VQA and WSA interpolation mode 0 = scanlines, 1 = vertical doubling, 2 = linear
     */
     ini.Put_Int("Video", "InterpolationMode", Video.InterpolationMode);
+
+    /*
+    ** Telemetry settings, only written once someone has turned it on.
+    */
+    if (!Telemetry.File.empty()) {
+        ini.Put_String("Telemetry", "File", Telemetry.File);
+    }
 }
@@ -34,6 +34,11 @@ public:
         std::string Driver;
         std::string PixelFormat;
     } Video;
+
+    struct
+    {
+        std::string File;
+    } Telemetry;
 };
 
 extern SettingsClass Settings;
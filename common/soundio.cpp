@@ -1440,6 +1440,14 @@ void Stop_Primary_Sound_Buffer()
     }
 }
 
+// Samples are decoded straight into DirectSound buffers, there is no decoded sample cache.
+void Get_Sample_Cache_Stats(SampleCacheStatsType* stats)
+{
+    if (stats != nullptr) {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
 void Suspend_Audio_Thread()
 {
     if (SoundThreadActive) {
@@ -1,4 +1,5 @@
 #include "audio.h"
+#include <string.h>
 
 void (*Audio_Focus_Loss_Function)(void) = nullptr;
 bool StreamLowImpact = false;
@@ -83,3 +84,9 @@ bool Start_Primary_Sound_Buffer(bool forced)
     return 0;
 };
 void Stop_Primary_Sound_Buffer(void){};
+void Get_Sample_Cache_Stats(SampleCacheStatsType* stats)
+{
+    if (stats != nullptr) {
+        memset(stats, 0, sizeof(*stats));
+    }
+};
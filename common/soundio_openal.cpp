@@ -11,7 +11,9 @@
 // with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
 #include "audio.h"
 #include "auduncmp.h"
+#include "crc.h"
 #include "file.h"
+#include "framearena.h"
 #include "memflag.h"
 #include "soscomp.h"
 #include "sound.h"
@@ -37,6 +39,11 @@ enum
     INVALID_AUDIO_HANDLE = -1,
     INVALID_FILE_HANDLE = -1,
     OPENAL_BUFFER_COUNT = 2,
+    SAMPLE_CACHE_ENTRIES = 128,
+    SAMPLE_CACHE_MAX_BYTES = 16 * 1024 * 1024, // Total decoded PCM kept resident.
+    SAMPLE_CACHE_MAX_SAMPLE = 1024 * 1024,     // Larger samples are always streamed.
+    SAMPLE_CACHE_CHECK_BYTES = 64,             // Leading sample bytes checked on a cache lookup.
+    INVALID_CACHE_INDEX = -1,
 };
 
 /*
@@ -187,6 +194,29 @@ struct SampleTrackerType
 
     // A set of buffers
     ALuint AudioBuffers[OPENAL_BUFFER_COUNT];
+
+    /*
+    **	This flags whether the source is playing a shared buffer from the
+    **	decoded sample cache rather than streaming through AudioBuffers.
+    */
+    bool Cached;
+    int CacheIndex;
+};
+
+/*
+**	Decoded sound effects are kept in shared OpenAL buffers so that playing a
+**	common effect again only needs the buffer attaching to a source. Entries
+**	are keyed on the sample pointer. Callers that load a different sample into
+**	the same buffer invalidate it, and as a cheap check against any that don't
+**	the header and the first few bytes of data must match as well.
+*/
+struct SampleCacheType
+{
+    const void* Sample; // Sample this entry was decoded from, nullptr if unused.
+    int32_t CRC;        // CRC of the header and the start of the sample data.
+    int Size;           // Size of the decoded PCM in bytes.
+    unsigned LastUsed;  // Use stamp for least recently used eviction.
+    ALuint Buffer;
 };
 
 struct LockedDataType
@@ -214,6 +244,9 @@ bool volatile AudioDone = false;
 ALCcontext* OpenALContext = nullptr;
 extern bool GameInFocus;
 static uint8_t ChunkBuffer[BUFFER_CHUNK_SIZE];
+static SampleCacheType SampleCache[SAMPLE_CACHE_ENTRIES];
+static SampleCacheStatsType SampleCacheStats;
+static unsigned SampleCacheClock = 0;
 
 unsigned int SoundTimerHandle;
 
@@ -396,6 +429,213 @@ int Sample_Copy(SampleTrackerType* st,
     return datasize;
 }
 
+static void Detach_Cached_Buffer(SampleTrackerType* st)
+{
+    alSourceStop(st->OpenALSource);
+    alSourcei(st->OpenALSource, AL_BUFFER, 0);
+    st->Cached = false;
+    st->CacheIndex = INVALID_CACHE_INDEX;
+}
+
+static bool Sample_Cache_In_Use(int index)
+{
+    for (int i = 0; i < MAX_SAMPLE_TRACKERS; ++i) {
+        if (LockedData.SampleTracker[i].Cached && LockedData.SampleTracker[i].CacheIndex == index) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void Sample_Cache_Release(int index)
+{
+    SampleCacheType* entry = &SampleCache[index];
+
+    if (entry->Sample == nullptr) {
+        return;
+    }
+
+    // Buffers can't be deleted while attached to a source so stop anything still using it.
+    for (int i = 0; i < MAX_SAMPLE_TRACKERS; ++i) {
+        SampleTrackerType* st = &LockedData.SampleTracker[i];
+
+        if (st->Cached && st->CacheIndex == index) {
+            Stop_Sample(i);
+
+            if (st->Cached) {
+                Detach_Cached_Buffer(st);
+            }
+        }
+    }
+
+    alDeleteBuffers(1, &entry->Buffer);
+    SampleCacheStats.ResidentBytes -= entry->Size;
+    --SampleCacheStats.Entries;
+    entry->Sample = nullptr;
+    entry->Buffer = 0;
+    entry->Size = 0;
+}
+
+/*
+**	Frees up a slot and enough resident bytes for a new entry by evicting the
+**	least recently used entries that aren't currently attached to a source.
+*/
+static int Sample_Cache_Make_Room(int size)
+{
+    for (;;) {
+        int free_index = INVALID_CACHE_INDEX;
+        int lru_index = INVALID_CACHE_INDEX;
+
+        for (int i = 0; i < SAMPLE_CACHE_ENTRIES; ++i) {
+            if (SampleCache[i].Sample == nullptr) {
+                if (free_index == INVALID_CACHE_INDEX) {
+                    free_index = i;
+                }
+            } else if (!Sample_Cache_In_Use(i)
+                       && (lru_index == INVALID_CACHE_INDEX
+                           || SampleCacheClock - SampleCache[i].LastUsed
+                                  > SampleCacheClock - SampleCache[lru_index].LastUsed)) {
+                lru_index = i;
+            }
+        }
+
+        if (free_index != INVALID_CACHE_INDEX && SampleCacheStats.ResidentBytes + size <= SAMPLE_CACHE_MAX_BYTES) {
+            return free_index;
+        }
+
+        if (lru_index == INVALID_CACHE_INDEX) {
+            return INVALID_CACHE_INDEX;
+        }
+
+        Sample_Cache_Release(lru_index);
+        ++SampleCacheStats.Evictions;
+    }
+}
+
+/*
+**	Returns the cache entry holding the decoded form of the sample, decoding and
+**	uploading it first if needed. Returns INVALID_CACHE_INDEX if the sample
+**	should be streamed instead.
+*/
+static int Sample_Cache_Fetch(SampleTrackerType* st, const void* sample, const AUDHeaderType& header)
+{
+    int size = header.Compression == SCOMP_NONE ? header.Size : header.UncompSize;
+
+    if (size <= 0 || size > SAMPLE_CACHE_MAX_SAMPLE || header.Size <= 0) {
+        return INVALID_CACHE_INDEX;
+    }
+
+    void* data = Add_Long_To_Pointer(sample, sizeof(AUDHeaderType));
+    int check = sizeof(AUDHeaderType) + std::min<int>(header.Size, SAMPLE_CACHE_CHECK_BYTES);
+    int32_t crc = Calculate_CRC((void*)sample, check);
+    ++SampleCacheClock;
+
+    for (int i = 0; i < SAMPLE_CACHE_ENTRIES; ++i) {
+        SampleCacheType* entry = &SampleCache[i];
+
+        if (entry->Sample != sample) {
+            continue;
+        }
+
+        if (entry->CRC == crc) {
+            entry->LastUsed = SampleCacheClock;
+            ++SampleCacheStats.Hits;
+            return i;
+        }
+
+        // The buffer has since been reloaded with a different sample so the old decode is stale.
+        if (!Sample_Cache_In_Use(i)) {
+            Sample_Cache_Release(i);
+        }
+    }
+
+    ++SampleCacheStats.Misses;
+
+    int index = Sample_Cache_Make_Room(size);
+
+    if (index == INVALID_CACHE_INDEX) {
+        return INVALID_CACHE_INDEX;
+    }
+
+    // The decoded copy is only needed until it has been handed to OpenAL.
+    FrameArenaClass& arena = FrameArenaClass::Thread();
+    size_t mark = arena.Mark();
+    void* pcm = arena.Alloc(size);
+
+    if (pcm == nullptr) {
+        return INVALID_CACHE_INDEX;
+    }
+
+    // Decode through a copy of the tracker so the codec state of the original is untouched if we fall back to streaming.
+    SampleTrackerType decoder = *st;
+    void* source = data;
+    int remainder = header.Size;
+    void* alternate = nullptr;
+    int altsize = 0;
+
+    int decoded = Sample_Copy(&decoder,
+                              &source,
+                              &remainder,
+                              &alternate,
+                              &altsize,
+                              pcm,
+                              size,
+                              st->Compression,
+                              nullptr,
+                              nullptr);
+
+    if (decoded <= 0) {
+        arena.Rewind(mark);
+        return INVALID_CACHE_INDEX;
+    }
+
+    SampleCacheType* entry = &SampleCache[index];
+
+    alGetError();
+    alGenBuffers(1, &entry->Buffer);
+    alBufferData(entry->Buffer, st->Format, pcm, decoded, st->Frequency);
+    arena.Rewind(mark);
+
+    if (alGetError() != AL_NO_ERROR) {
+        alDeleteBuffers(1, &entry->Buffer);
+        entry->Buffer = 0;
+        return INVALID_CACHE_INDEX;
+    }
+
+    entry->Sample = sample;
+    entry->CRC = crc;
+    entry->Size = decoded;
+    entry->LastUsed = SampleCacheClock;
+    SampleCacheStats.ResidentBytes += decoded;
+    ++SampleCacheStats.Entries;
+
+    return index;
+}
+
+static void Sample_Cache_Invalidate(const void* sample)
+{
+    for (int i = 0; i < SAMPLE_CACHE_ENTRIES; ++i) {
+        if (SampleCache[i].Sample == sample) {
+            Sample_Cache_Release(i);
+        }
+    }
+}
+
+static void Sample_Cache_Clear()
+{
+    for (int i = 0; i < SAMPLE_CACHE_ENTRIES; ++i) {
+        Sample_Cache_Release(i);
+    }
+}
+
+void Get_Sample_Cache_Stats(SampleCacheStatsType* stats)
+{
+    if (stats != nullptr) {
+        *stats = SampleCacheStats;
+    }
+}
+
 int File_Stream_Sample(const char* filename, bool real_time_start)
 {
     return File_Stream_Sample_Vol(filename, VOLUME_MAX, real_time_start);
@@ -784,6 +1024,9 @@ long Load_Sample_Into_Buffer(char const* filename, void* buffer, long size)
         return 0;
     }
 
+    // Whatever was decoded from this buffer previously is about to be replaced.
+    Sample_Cache_Invalidate(buffer);
+
     int sample_size = Sample_Read(handle, buffer, size);
     Close_File(handle);
     return sample_size;
@@ -809,6 +1052,7 @@ long Sample_Read(int fh, void* buffer, long size)
 void Free_Sample(const void* sample)
 {
     if (sample != nullptr) {
+        Sample_Cache_Invalidate(sample);
         free((void*)sample);
     }
 };
@@ -864,6 +1108,8 @@ bool Audio_Init(int bits_per_sample, bool stereo, int rate, bool reverse_channel
 
         st->Frequency = rate;
         st->Format = Get_OpenAL_Format(bits_per_sample, stereo ? 2 : 1);
+        st->Cached = false;
+        st->CacheIndex = INVALID_CACHE_INDEX;
     }
 
     SoundType = SFX_ALFX;
@@ -887,6 +1133,8 @@ void Sound_End()
         FileStreamBuffer = nullptr;
     }
 
+    Sample_Cache_Clear();
+
     ALCdevice* device = alcGetContextsDevice(OpenALContext);
 
     alcMakeContextCurrent(nullptr);
@@ -915,7 +1163,9 @@ void Stop_Sample(int index)
 
             st->Priority = 0;
 
-            if (!st->Loading) {
+            if (st->Cached) {
+                Detach_Cached_Buffer(st);
+            } else if (!st->Loading) {
                 ALint processed_count = -1;
                 alSourceStop(st->OpenALSource);
                 alGetSourcei(st->OpenALSource, AL_BUFFERS_PROCESSED, &processed_count);
@@ -1093,7 +1343,37 @@ int Play_Sample_Handle(const void* sample, int priority, int volume, signed shor
                 alSourceUnqueueBuffers(st->OpenALSource, 1, &tmp);
             }
 
-            alDeleteBuffers(OPENAL_BUFFER_COUNT, st->AudioBuffers);
+            if (!st->Cached) {
+                alDeleteBuffers(OPENAL_BUFFER_COUNT, st->AudioBuffers);
+            }
+        }
+
+        // A shared cache buffer stays attached after playback ends, it must be detached before queuing anything.
+        if (st->Cached) {
+            Detach_Cached_Buffer(st);
+        }
+
+        // Sound effects are played from the decoded sample cache, streamed scores are not.
+        if (!StartingFileStream) {
+            int cache_index = Sample_Cache_Fetch(st, sample, raw_header);
+
+            if (cache_index != INVALID_CACHE_INDEX) {
+                alSourcei(st->OpenALSource, AL_BUFFER, SampleCache[cache_index].Buffer);
+                st->Cached = true;
+                st->CacheIndex = cache_index;
+                st->MoreSource = false;
+                st->OneShot = true;
+                st->Service = 1;
+                st->Volume = volume;
+
+                alSourcef(st->OpenALSource, AL_GAIN, ((LockedData.SoundVolume * st->Volume) / 256) / 256.0f);
+
+                if (!Start_Primary_Sound_Buffer(false)) {
+                    return INVALID_AUDIO_HANDLE;
+                }
+
+                return Attempt_To_Play_Buffer(id);
+            }
         }
 
         alGenBuffers(OPENAL_BUFFER_COUNT, st->AudioBuffers);
@@ -11,6 +11,7 @@
 // with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
 #include "endianness.h"
 #include "graphicsviewport.h"
+#include "stamprow.h"
 #include <string.h>
 #include <stdint.h>
 
@@ -103,6 +104,28 @@ void Init_Stamps(const IconControlType* iconset)
     }
 }
 
+/*
+** Remapped rows are looked up into a scratch row first, the lookup has no SIMD
+** form for a 256 entry table, then blended like any other transparent row.
+*/
+static inline void Stamp_Remap_Row(uint8_t* dst, const uint8_t* src, int width, const uint8_t* remap)
+{
+    uint8_t row[256];
+
+    while (width > 0) {
+        int chunk = width < int(sizeof(row)) ? width : int(sizeof(row));
+
+        for (int j = 0; j < chunk; ++j) {
+            row[j] = remap[src[j]];
+        }
+
+        Stamp_Trans_Row(dst, row, chunk);
+        dst += chunk;
+        src += chunk;
+        width -= chunk;
+    }
+}
+
 void Buffer_Draw_Stamp(void* thisptr, void* icondata, int icon, int x, int y, const void* remapper)
 {
     GraphicViewPortClass& viewport = *static_cast<GraphicViewPortClass*>(thisptr);
@@ -122,38 +145,21 @@ void Buffer_Draw_Stamp(void* thisptr, void* icondata, int icon, int x, int y, co
 
         int32_t fullpitch = viewport.Get_Pitch() + viewport.Get_XAdd() + viewport.Get_Width();
         uint8_t* dst = x + y * fullpitch + reinterpret_cast<uint8_t*>(viewport.Get_Offset());
-        int32_t blitpitch = fullpitch - IconWidth;
         const uint8_t* src = &StampPtr[IconSize * icon_index];
 
         if (remapper) {
             const uint8_t* remap = static_cast<const uint8_t*>(remapper);
             for (int i = 0; i < IconHeight; ++i) {
-                for (int j = 0; j < IconWidth; ++j) {
-                    uint8_t cur_byte = remap[*src++];
-
-                    if (cur_byte) {
-                        *dst = cur_byte;
-                    }
-
-                    ++dst;
-                }
-
-                dst += blitpitch;
+                Stamp_Remap_Row(dst, src, IconWidth, remap);
+                src += IconWidth;
+                dst += fullpitch;
             }
 
         } else if (TransFlagPtr[icon_index]) {
             for (int i = 0; i < IconHeight; ++i) {
-                for (int j = 0; j < IconWidth; ++j) {
-                    uint8_t cur_byte = *src++;
-
-                    if (cur_byte) {
-                        *dst = cur_byte;
-                    }
-
-                    ++dst;
-                }
-
-                dst += blitpitch;
+                Stamp_Trans_Row(dst, src, IconWidth);
+                src += IconWidth;
+                dst += fullpitch;
             }
         } else {
             for (int32_t i = 0; i < IconHeight; ++i) {
@@ -205,10 +211,7 @@ void Buffer_Draw_Stamp_Clip(void const* thisptr,
                 xstart = left;
             }
 
-            int src_pitch = IconWidth - blit_width;
-
             if (blit_width + xstart > width) {
-                src_pitch += blit_width - (width - xstart);
                 blit_width = width - xstart;
             }
 
@@ -224,34 +227,20 @@ void Buffer_Draw_Stamp_Clip(void const* thisptr,
 
             int full_pitch = viewport.Get_Pitch() + viewport.Get_XAdd() + viewport.Get_Width();
             uint8_t* dst = xstart + ystart * full_pitch + reinterpret_cast<uint8_t*>(viewport.Get_Offset());
-            int dst_pitch = full_pitch - blit_width;
 
             if (remapper) {
                 const uint8_t* remap = static_cast<const uint8_t*>(remapper);
                 for (int i = 0; i < blit_height; ++i) {
-                    for (int j = 0; j < blit_width; ++j) {
-                        uint8_t cur_byte = remap[*src++];
-                        if (cur_byte) {
-                            *dst = cur_byte;
-                        }
-
-                        ++dst;
-                    }
-                    dst += dst_pitch;
+                    Stamp_Remap_Row(dst, src, blit_width, remap);
+                    src += IconWidth;
+                    dst += full_pitch;
                 }
 
             } else if (TransFlagPtr[icon_index]) {
                 for (int i = 0; i < blit_height; ++i) {
-                    for (int j = 0; j < blit_width; ++j) {
-                        uint8_t cur_byte = *src++;
-                        if (cur_byte) {
-                            *dst = cur_byte;
-                        }
-
-                        ++dst;
-                    }
-                    src += src_pitch;
-                    dst += dst_pitch;
+                    Stamp_Trans_Row(dst, src, blit_width);
+                    src += IconWidth;
+                    dst += full_pitch;
                 }
 
             } else {
@@ -0,0 +1,73 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef STAMPROW_H
+#define STAMPROW_H
+
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STAMP_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define STAMP_NEON
+#endif
+
+/*
+** Copies one row of a stamp or font glyph, leaving the destination alone wherever
+** the source is colour 0. Rows are done 16 and then 8 pixels at a time with a
+** masked blend where the target has SIMD, a 24 pixel icon row takes one of each.
+*/
+static inline void Stamp_Trans_Row(uint8_t* dst, const uint8_t* src, int width)
+{
+    int j = 0;
+
+#if defined(STAMP_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; j + 16 <= width; j += 16) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + j));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + j));
+        __m128i keep = _mm_cmpeq_epi8(s, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j), _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, s)));
+    }
+
+    for (; j + 8 <= width; j += 8) {
+        __m128i s = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + j));
+        __m128i d = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(dst + j));
+        __m128i keep = _mm_cmpeq_epi8(s, zero);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, s)));
+    }
+#elif defined(STAMP_NEON)
+    for (; j + 16 <= width; j += 16) {
+        uint8x16_t s = vld1q_u8(src + j);
+        uint8x16_t d = vld1q_u8(dst + j);
+        vst1q_u8(dst + j, vbslq_u8(vceqq_u8(s, vdupq_n_u8(0)), d, s));
+    }
+
+    for (; j + 8 <= width; j += 8) {
+        uint8x8_t s = vld1_u8(src + j);
+        uint8x8_t d = vld1_u8(dst + j);
+        vst1_u8(dst + j, vbsl_u8(vceq_u8(s, vdup_n_u8(0)), d, s));
+    }
+#endif
+
+    for (; j < width; ++j) {
+        uint8_t cur_byte = src[j];
+
+        if (cur_byte) {
+            dst[j] = cur_byte;
+        }
+    }
+}
+
+#endif
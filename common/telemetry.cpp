@@ -0,0 +1,235 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "telemetry.h"
+#include <assert.h>
+#include <inttypes.h>
+#include <string.h>
+#include <chrono>
+
+TelemetryClass Telemetry;
+
+static int64_t Microseconds(void)
+{
+    return (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+}
+
+TelemetryClass::TelemetryClass()
+    : File(nullptr)
+    , IsJSON(false)
+    , IsHeaderDone(false)
+    , FieldCount(0)
+    , ColumnCount(0)
+    , Ring(nullptr)
+    , RingUsed(0)
+{
+    memset(Names, 0, sizeof(Names));
+    memset(Kinds, 0, sizeof(Kinds));
+    memset(Values, 0, sizeof(Values));
+    memset(Calls, 0, sizeof(Calls));
+    for (int i = 0; i < MAX_FIELDS; i++) {
+        Started[i] = -1;
+    }
+}
+
+TelemetryClass::~TelemetryClass()
+{
+    Close();
+}
+
+/*
+**	Names a field. Fields must all be defined before the first frame is recorded,
+**	since the columns of the file are fixed from then on.
+*/
+void TelemetryClass::Define(int field, char const* name, FieldKindType kind)
+{
+    assert(field >= 0 && field < MAX_FIELDS);
+    assert(!IsHeaderDone);
+
+    if (field < 0 || field >= MAX_FIELDS || IsHeaderDone) {
+        return;
+    }
+
+    if (Kinds[field] != FIELD_NONE) {
+        ColumnCount -= (Kinds[field] == FIELD_TIMER) ? 2 : 1;
+    }
+    strncpy(Names[field], name, sizeof(Names[field]) - 1);
+    Kinds[field] = kind;
+    ColumnCount += (kind == FIELD_TIMER) ? 2 : (kind != FIELD_NONE ? 1 : 0);
+    if (field >= FieldCount) {
+        FieldCount = field + 1;
+    }
+}
+
+bool TelemetryClass::Open(char const* filename)
+{
+    Close();
+
+    File = fopen(filename, "w");
+    if (File == nullptr) {
+        return (false);
+    }
+
+    size_t len = strlen(filename);
+    IsJSON = (len >= 5 && strcmp(filename + len - 5, ".json") == 0)
+             || (len >= 6 && strcmp(filename + len - 6, ".jsonl") == 0);
+    IsHeaderDone = false;
+
+    Ring = new int64_t[RING_FRAMES * (MAX_FIELDS * 2 + 1)];
+    RingUsed = 0;
+
+    memset(Values, 0, sizeof(Values));
+    memset(Calls, 0, sizeof(Calls));
+    for (int i = 0; i < MAX_FIELDS; i++) {
+        Started[i] = -1;
+    }
+    return (true);
+}
+
+void TelemetryClass::Close(void)
+{
+    if (File == nullptr) {
+        return;
+    }
+
+    Flush();
+    fclose(File);
+    File = nullptr;
+    delete[] Ring;
+    Ring = nullptr;
+}
+
+/*
+**	Timers nest by field: a second Begin before the End restarts the clock, and an
+**	End without a Begin is ignored, so a routine with many exits can end the timer
+**	on each of them.
+*/
+void TelemetryClass::Start_Timer(int field)
+{
+    Started[field] = Microseconds();
+    Calls[field]++;
+}
+
+void TelemetryClass::Stop_Timer(int field)
+{
+    if (Started[field] >= 0) {
+        Values[field] += Microseconds() - Started[field];
+        Started[field] = -1;
+    }
+}
+
+/*
+**	Stores the frame's values in the ring and clears the counts and timers for
+**	the next frame. The ring is written out once it is full.
+*/
+void TelemetryClass::End_Frame(long frame)
+{
+    if (File == nullptr) {
+        return;
+    }
+    IsHeaderDone = true;
+
+    int64_t* record = Ring + RingUsed * Columns();
+    *record++ = frame;
+
+    for (int field = 0; field < FieldCount; field++) {
+        switch (Kinds[field]) {
+        case FIELD_COUNT:
+            *record++ = Values[field];
+            Values[field] = 0;
+            break;
+
+        case FIELD_VALUE:
+            *record++ = Values[field];
+            break;
+
+        case FIELD_TIMER:
+            *record++ = Values[field];
+            *record++ = Calls[field];
+            Values[field] = 0;
+            Calls[field] = 0;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (++RingUsed == RING_FRAMES) {
+        Flush();
+    }
+}
+
+void TelemetryClass::Flush(void)
+{
+    if (File == nullptr || RingUsed == 0) {
+        return;
+    }
+
+    Write_Header();
+    for (int i = 0; i < RingUsed; i++) {
+        Write_Record(Ring + i * Columns());
+    }
+    RingUsed = 0;
+    fflush(File);
+}
+
+void TelemetryClass::Write_Header(void)
+{
+    /*
+    **	Each JSON line names its own fields, so only CSV has a header line.
+    */
+    if (IsJSON || ftell(File) != 0) {
+        return;
+    }
+
+    fputs("frame", File);
+    for (int field = 0; field < FieldCount; field++) {
+        if (Kinds[field] == FIELD_TIMER) {
+            fprintf(File, ",%s_us,%s_calls", Names[field], Names[field]);
+        } else if (Kinds[field] != FIELD_NONE) {
+            fprintf(File, ",%s", Names[field]);
+        }
+    }
+    fputc('\n', File);
+}
+
+void TelemetryClass::Write_Record(int64_t const* record)
+{
+    if (IsJSON) {
+        fprintf(File, "{\"frame\":%" PRId64, *record++);
+    } else {
+        fprintf(File, "%" PRId64, *record++);
+    }
+
+    for (int field = 0; field < FieldCount; field++) {
+        if (Kinds[field] == FIELD_NONE) {
+            continue;
+        }
+
+        if (IsJSON) {
+            if (Kinds[field] == FIELD_TIMER) {
+                fprintf(File, ",\"%s_us\":%" PRId64, Names[field], *record++);
+                fprintf(File, ",\"%s_calls\":%" PRId64, Names[field], *record++);
+            } else {
+                fprintf(File, ",\"%s\":%" PRId64, Names[field], *record++);
+            }
+        } else {
+            if (Kinds[field] == FIELD_TIMER) {
+                fprintf(File, ",%" PRId64, *record++);
+            }
+            fprintf(File, ",%" PRId64, *record++);
+        }
+    }
+
+    fputs(IsJSON ? "}\n" : "\n", File);
+}
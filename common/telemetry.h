@@ -0,0 +1,121 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+**	Per frame statistics written to a file for later study. The game defines the
+**	fields it reports once at startup, then counts, sets and times them during the
+**	frame. End_Frame copies the values into a ring of binary records and clears
+**	them; the ring is written out as CSV, or as one JSON object per line when the
+**	file name ends in ".json" or ".jsonl", whenever it fills and on Close.
+**
+**	Nothing is recorded unless a file is open, so the calls can stay in place.
+*/
+class TelemetryClass
+{
+public:
+    enum
+    {
+        MAX_FIELDS = 64,
+        RING_FRAMES = 256
+    };
+
+    typedef enum FieldKindType : unsigned char
+    {
+        FIELD_NONE,
+        FIELD_COUNT, // Summed over the frame, cleared after each one.
+        FIELD_VALUE, // Level set during the frame, kept until changed.
+        FIELD_TIMER  // Microseconds between Begin and End, plus the number of calls.
+    } FieldKindType;
+
+    TelemetryClass();
+    ~TelemetryClass();
+
+    void Define(int field, char const* name, FieldKindType kind);
+    bool Open(char const* filename);
+    void Close(void);
+
+    bool Is_Enabled(void) const
+    {
+        return (File != nullptr);
+    }
+
+    void Add(int field, int64_t amount = 1)
+    {
+        if (File != nullptr) {
+            Values[field] += amount;
+        }
+    }
+    void Set(int field, int64_t value)
+    {
+        if (File != nullptr) {
+            Values[field] = value;
+        }
+    }
+    void Begin(int field)
+    {
+        if (File != nullptr) {
+            Start_Timer(field);
+        }
+    }
+    void End(int field)
+    {
+        if (File != nullptr) {
+            Stop_Timer(field);
+        }
+    }
+
+    void End_Frame(long frame);
+    void Flush(void);
+
+private:
+    TelemetryClass(TelemetryClass const&);
+    TelemetryClass& operator=(TelemetryClass const&);
+
+    void Start_Timer(int field);
+    void Stop_Timer(int field);
+    void Write_Header(void);
+    void Write_Record(int64_t const* record);
+
+    /*
+    **	A record is the frame number followed by one value per column. Timers take
+    **	two columns, the time and the number of calls.
+    */
+    int Columns(void) const
+    {
+        return (ColumnCount + 1);
+    }
+
+    FILE* File;
+    bool IsJSON;
+    bool IsHeaderDone;
+
+    char Names[MAX_FIELDS][32];
+    FieldKindType Kinds[MAX_FIELDS];
+    int FieldCount;   // highest defined field plus one
+    int ColumnCount;  // columns the defined fields take up
+
+    int64_t Values[MAX_FIELDS];
+    int64_t Calls[MAX_FIELDS];
+    int64_t Started[MAX_FIELDS]; // timer start in microseconds, or -1 when not running
+
+    int64_t* Ring;
+    int RingUsed; // records waiting to be written
+};
+
+extern TelemetryClass Telemetry;
+
+#endif
@@ -38,6 +38,7 @@
 /*= = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =*/
 
 #include "gbuffer.h"
+#include "palconv.h"
 #include "palette.h"
 #include "video.h"
 #include "wwkeyboard.h"
@@ -46,12 +47,17 @@
 #include "debugstring.h"
 
 #include <SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <string.h>
 
 static SDL_Window* window;
 static SDL_Renderer* renderer;
 static SDL_Palette* palette;
 static Uint32 pixel_format;
 static SDL_Rect render_dst;
+static std::atomic<bool> render_full(true);
+static bool render_cursor = true;
 
 static struct
 {
@@ -118,6 +124,25 @@ Uint32 SettingsPixelFormat()
 
 static void Update_HWCursor();
 
+/*
+** The window contents may be lost or rescaled by these events, so the next frame is presented whole even if the
+** game hasn't drawn anything new. SDL may call event watches from whichever thread posts the event, which is why
+** render_full is atomic.
+*/
+static int SDLCALL Render_Event_Watch(void* userdata, SDL_Event* event)
+{
+    if (event->type == SDL_WINDOWEVENT) {
+        switch (event->window.event) {
+        case SDL_WINDOWEVENT_EXPOSED:
+        case SDL_WINDOWEVENT_RESTORED:
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+            render_full = true;
+            break;
+        }
+    }
+    return 0;
+}
+
 static void Update_HWCursor_Settings()
 {
     /*
@@ -236,6 +261,8 @@ bool Set_Video_Mode(int w, int h, int bits_per_pixel)
 
     DBG_INFO("Created SDL2 %s window in %dx%d", (win_flags ? "fullscreen" : "windowed"), win_w, win_h);
 
+    SDL_AddEventWatch(Render_Event_Watch, nullptr);
+
     pixel_format = SDL_GetWindowPixelFormat(window);
     if (pixel_format == SDL_PIXELFORMAT_UNKNOWN || SDL_BITSPERPIXEL(pixel_format) < 16) {
         DBG_ERROR("SDL2 window pixel format unsupported: %s (%d bpp)",
@@ -445,6 +472,8 @@ void Get_Video_Mouse(int& x, int& y)
  *=============================================================================================*/
 void Reset_Video_Mode(void)
 {
+    SDL_DelEventWatch(Render_Event_Watch, nullptr);
+
     if (hwcursor.Pending) {
         SDL_FreeCursor(hwcursor.Pending);
         hwcursor.Pending = nullptr;
@@ -543,6 +572,7 @@ void Set_Video_Cursor(void* cursor, int w, int h, int hotx, int hoty)
     hwcursor.H = h;
     hwcursor.HotX = hotx;
     hwcursor.HotY = hoty;
+    render_cursor = true;
 
     Update_HWCursor();
 }
@@ -634,6 +664,11 @@ void Set_DD_Palette(void* rpalette)
 
     SDL_SetPaletteColors(palette, colors, 0, 256);
 
+    /*
+    ** Every pixel on screen converts to a new color, so the next frame is uploaded whole.
+    */
+    render_full = true;
+
     /*
     ** Cursor needs to be updated when palette changes.
     */
@@ -692,6 +727,12 @@ public:
         : flags(flags)
         , windowSurface(nullptr)
         , texture(nullptr)
+        , shadow(nullptr)
+        , dirty(0, 0, 0, 0)
+        , cursorRect{0, 0, 0, 0}
+        , cursorX(0)
+        , cursorY(0)
+        , cursorShown(false)
     {
         surface = SDL_CreateRGBSurface(0, w, h, 8, 0, 0, 0, 0);
         SDL_SetSurfacePalette(surface, palette);
@@ -699,7 +740,9 @@ public:
         if (flags & GBC_VISIBLE) {
             windowSurface = SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(pixel_format), pixel_format);
             texture = SDL_CreateTexture(renderer, windowSurface->format->format, SDL_TEXTUREACCESS_STREAMING, w, h);
+            shadow = new unsigned char[w * h];
             frontSurface = this;
+            render_full = true;
         }
     }
 
@@ -718,6 +761,8 @@ public:
         if (windowSurface) {
             SDL_FreeSurface(windowSurface);
         }
+
+        delete[] shadow;
     }
 
     virtual void* GetData() const
@@ -744,6 +789,10 @@ public:
 
     virtual bool LockWait()
     {
+        /*
+        ** Anything may be drawn through a lock, so the whole surface has to be checked at the next frame.
+        */
+        Mark_Dirty(Rect(0, 0, surface->w, surface->h));
         return (SDL_LockSurface(surface) == 0);
     }
 
@@ -755,20 +804,95 @@ public:
 
     virtual void Blt(const Rect& destRect, VideoSurface* src, const Rect& srcRect, bool mask)
     {
+        /*
+        ** SDL clips the destination rectangle in place, leaving just the pixels written.
+        */
         SDL_BlitSurface(((VideoSurfaceSDL2*)src)->surface, (SDL_Rect*)(&srcRect), surface, (SDL_Rect*)&destRect);
+        Mark_Dirty(destRect);
     }
 
     virtual void FillRect(const Rect& rect, unsigned char color)
     {
         SDL_FillRect(surface, (SDL_Rect*)(&rect), color);
+        Mark_Dirty(rect.Intersect(Rect(0, 0, surface->w, surface->h)));
     }
 
     void RenderSurface()
     {
-        void* pixels;
-        int pitch;
+        SDL_Rect update;
 
-        SDL_BlitSurface(surface, NULL, windowSurface, NULL);
+        /*
+        ** The lock marks the surface dirty only when it is first taken. A surface still locked now may have been
+        ** drawn to since the last frame without that being noted, so all of it is checked again.
+        */
+        if (surface->locked) {
+            Mark_Dirty(Rect(0, 0, surface->w, surface->h));
+        }
+
+        /*
+        ** Only the part of the frame that differs from the last one presented is converted and uploaded.
+        */
+        if (render_full.exchange(false)) {
+            update.x = 0;
+            update.y = 0;
+            update.w = surface->w;
+            update.h = surface->h;
+            for (int y = 0; y < surface->h; y++) {
+                memcpy(shadow + y * surface->w, (unsigned char*)surface->pixels + y * surface->pitch, surface->w);
+            }
+
+            /*
+            ** A full update follows every palette change, so the output colors are looked up again here. Mapping
+            ** them through SDL gives exactly the pixels SDL's own blit would.
+            */
+            for (int i = 0; i < 256; i++) {
+                SDL_Color& color = palette->colors[i];
+                lut[i] = SDL_MapRGBA(windowSurface->format, color.r, color.g, color.b, color.a);
+            }
+        } else {
+            update = Changed_Rect();
+        }
+        dirty = Rect(0, 0, 0, 0);
+
+        /*
+        ** With the game surface unchanged and the cursor as it was, the frame on screen is still correct and
+        ** neither the upload nor the present is needed. Idle screens and the frames between slow game ticks end
+        ** here.
+        */
+        int mouse_x, mouse_y;
+        bool shown = !Get_Mouse_State();
+        Get_Video_Mouse(mouse_x, mouse_y);
+
+        if (update.w <= 0 && !render_cursor && shown == cursorShown
+            && (Settings.Video.HardwareCursor || (mouse_x == cursorX && mouse_y == cursorY))) {
+            return;
+        }
+        render_cursor = false;
+        cursorShown = shown;
+        cursorX = mouse_x;
+        cursorY = mouse_y;
+
+        /*
+        ** Whatever the software cursor covered last frame has to be restored from the game surface as well.
+        */
+        Union_Rect(update, cursorRect);
+        cursorRect.w = 0;
+        cursorRect.h = 0;
+
+        if (update.w > 0) {
+            if (windowSurface->format->BytesPerPixel == 4) {
+                Palette_Expand((unsigned char*)windowSurface->pixels + update.y * windowSurface->pitch + update.x * 4,
+                               windowSurface->pitch,
+                               (unsigned char*)surface->pixels + update.y * surface->pitch + update.x,
+                               surface->pitch,
+                               update.w,
+                               update.h,
+                               lut);
+            } else {
+                SDL_Rect dst = update;
+                SDL_BlitSurface(surface, &update, windowSurface, &dst);
+            }
+        }
 
         if (Settings.Video.HardwareCursor) {
             /*
@@ -788,35 +912,140 @@ public:
             /*
             ** Update hardware cursor visibility.
             */
-            SDL_ShowCursor(!Get_Mouse_State());
-        } else if (!Get_Mouse_State() && hwcursor.Surface != nullptr) {
+            SDL_ShowCursor(shown);
+        } else if (shown && hwcursor.Surface != nullptr) {
             /*
             ** Draw software emulated cursor.
             */
-            int x, y;
             SDL_Rect dst;
 
-            Get_Video_Mouse(x, y);
-
-            dst.x = x - hwcursor.HotX;
-            dst.y = y - hwcursor.HotY;
+            dst.x = mouse_x - hwcursor.HotX;
+            dst.y = mouse_y - hwcursor.HotY;
             dst.w = hwcursor.Surface->w;
             dst.h = hwcursor.Surface->h;
 
-            SDL_BlitSurface(hwcursor.Surface, nullptr, windowSurface, &dst);
+            /*
+            ** The blit clips dst to the pixels actually covered.
+            */
+            if (SDL_BlitSurface(hwcursor.Surface, nullptr, windowSurface, &dst) == 0 && dst.w > 0 && dst.h > 0) {
+                cursorRect = dst;
+                Union_Rect(update, cursorRect);
+            }
+        }
+
+        if (update.w > 0) {
+            unsigned char* pixels = (unsigned char*)windowSurface->pixels + update.y * windowSurface->pitch
+                                    + update.x * windowSurface->format->BytesPerPixel;
+            SDL_UpdateTexture(texture, &update, pixels, windowSurface->pitch);
         }
 
-        SDL_UpdateTexture(texture, NULL, windowSurface->pixels, windowSurface->pitch);
         SDL_RenderClear(renderer);
         SDL_RenderCopy(renderer, texture, NULL, &render_dst);
         SDL_RenderPresent(renderer);
     }
 
 private:
+    void Mark_Dirty(const Rect& rect)
+    {
+        if (shadow == nullptr || !rect.Is_Valid()) {
+            return;
+        }
+
+        if (!dirty.Is_Valid()) {
+            dirty = rect;
+            return;
+        }
+
+        int x1 = std::min(dirty.X, rect.X);
+        int y1 = std::min(dirty.Y, rect.Y);
+        int x2 = std::max(dirty.X + dirty.Width, rect.X + rect.Width);
+        int y2 = std::max(dirty.Y + dirty.Height, rect.Y + rect.Height);
+        dirty = Rect(x1, y1, x2 - x1, y2 - y1);
+    }
+
+    static void Union_Rect(SDL_Rect& rect, const SDL_Rect& add)
+    {
+        if (add.w <= 0 || add.h <= 0) {
+            return;
+        }
+
+        if (rect.w <= 0 || rect.h <= 0) {
+            rect = add;
+            return;
+        }
+
+        int x1 = std::min(rect.x, add.x);
+        int y1 = std::min(rect.y, add.y);
+        int x2 = std::max(rect.x + rect.w, add.x + add.w);
+        int y2 = std::max(rect.y + rect.h, add.y + add.h);
+        rect.x = x1;
+        rect.y = y1;
+        rect.w = x2 - x1;
+        rect.h = y2 - y1;
+    }
+
+    /*
+    ** Compares the area drawn to since the last frame against the copy of that frame and brings the copy up to
+    ** date. Returns the bounding rectangle of the pixels that actually changed, which is empty if none did.
+    */
+    SDL_Rect Changed_Rect()
+    {
+        SDL_Rect changed = {0, 0, 0, 0};
+        Rect area = dirty.Intersect(Rect(0, 0, surface->w, surface->h));
+
+        if (!area.Is_Valid()) {
+            return changed;
+        }
+
+        int x1 = area.X + area.Width;
+        int x2 = area.X;
+        int y1 = area.Y + area.Height;
+        int y2 = area.Y;
+
+        for (int y = area.Y; y < area.Y + area.Height; y++) {
+            unsigned char const* src = (unsigned char const*)surface->pixels + y * surface->pitch;
+            unsigned char* old = shadow + y * surface->w;
+
+            if (memcmp(src + area.X, old + area.X, area.Width) == 0) {
+                continue;
+            }
+
+            int left = area.X;
+            while (src[left] == old[left]) {
+                left++;
+            }
+            int right = area.X + area.Width;
+            while (src[right - 1] == old[right - 1]) {
+                right--;
+            }
+            memcpy(old + left, src + left, right - left);
+
+            x1 = std::min(x1, left);
+            x2 = std::max(x2, right);
+            y1 = std::min(y1, y);
+            y2 = y + 1;
+        }
+
+        if (x1 < x2) {
+            changed.x = x1;
+            changed.y = y1;
+            changed.w = x2 - x1;
+            changed.h = y2 - y1;
+        }
+        return changed;
+    }
+
     SDL_Surface* surface;
     SDL_Surface* windowSurface;
     SDL_Texture* texture;
     GBC_Enum flags;
+    unsigned char* shadow; // Last frame presented, front surface only.
+    Rect dirty;            // Area written since the last frame.
+    SDL_Rect cursorRect;   // Area the software cursor was drawn over.
+    int cursorX;           // Mouse position at the last frame presented.
+    int cursorY;
+    bool cursorShown;      // Cursor visibility at the last frame presented.
+    uint32_t lut[256];     // Palette in the window surface format.
 };
 
 void Video_Render_Frame()
@@ -33,6 +33,7 @@ static VQAConfig _defaultconfig = {
     VQAOPTF_AUDIO, // OptionFlags
     6,             // NumFrameBufs
     3,             // NumCBBufs
+    8,             // NumReadAheadBufs
 #if defined _WIN32 && !defined OPENAL_BUILD
     NULL, // SoundObject
     NULL, // PrimarySoundBuffer
@@ -68,6 +68,7 @@ typedef struct _VQAConfig
     int OptionFlags; // VQAOptionEnum
     int NumFrameBufs;
     int NumCBBufs;
+    int NumReadAheadBufs; // Blocks of file data read ahead on a background thread, 0 to read inline.
 #if defined _WIN32 && !defined OPENAL_BUILD
     LPDIRECTSOUND SoundObject;
     LPDIRECTSOUNDBUFFER PrimaryBufferPtr;
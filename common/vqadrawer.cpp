@@ -17,6 +17,7 @@
 #include "vqafile.h"
 #include "vqaloader.h"
 #include "vqapalette.h"
+#include "vqastream.h"
 #include <string.h>
 
 int VQA_DrawFrame_Buffer(VQAHandle* handle)
@@ -326,6 +327,7 @@ void VQA_PrepareFrame(VQAData* vqabuf)
 {
     VQAFrameNode* curframe = vqabuf->Drawer.CurFrame;
     VQACBNode* codebook = curframe->Codebook;
+    unsigned start = VQA_GetMicroseconds();
 
     if (codebook->Flags & 0x02) {
         LCW_Uncompress(&codebook->Buffer[codebook->CBOffset], codebook->Buffer, vqabuf->MaxCBSize);
@@ -342,4 +344,11 @@ void VQA_PrepareFrame(VQAData* vqabuf)
         LCW_Uncompress(&curframe->Pointers[curframe->PtrOffset], curframe->Pointers, vqabuf->MaxPtrSize);
         curframe->Flags &= ~0x10;
     }
+
+    unsigned elapsed = VQA_GetMicroseconds() - start;
+    vqabuf->DecodeTime += elapsed;
+
+    if (elapsed > vqabuf->MaxFrameDecodeTime) {
+        vqabuf->MaxFrameDecodeTime = elapsed;
+    }
 }
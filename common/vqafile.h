@@ -17,6 +17,7 @@
 #include "vqadrawer.h"
 
 typedef struct _CaptionInfo CaptionInfo;
+typedef struct _VQAStream VQAStream;
 
 typedef enum
 {
@@ -165,6 +166,7 @@ typedef struct _VQAHandle
     int VocFH;
     CaptionInfo* field_BE; // EVA info?
     CaptionInfo* field_C2; // Captions info?
+    VQAStream* Stream;     // Read ahead state wrapping StreamHandler, see vqastream.h.
 } VQAHandle;
 
 typedef struct _VQAChunkHeader
@@ -18,6 +18,7 @@
 #include "misc.h"
 #include "vqacaption.h"
 #include "vqaconfig.h"
+#include "vqastream.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -722,6 +723,9 @@ int VQA_Open(VQAHandle* handle, const char* filename, VQAConfig* config)
             }
         }
 
+        // Only frame chunks follow the frame info, so from here on the file can be read ahead of the loader.
+        VQA_StartStream(handle);
+
         if (VQA_PrimeBuffers(handle)) {
             VQA_Close(handle);
             return VQAERR_READ;
@@ -733,6 +737,8 @@ int VQA_Open(VQAHandle* handle, const char* filename, VQAConfig* config)
 
 void VQA_Close(VQAHandle* handle)
 {
+    VQA_StopStream(handle);
+
     if (handle->Config.OptionFlags & 1) {
         VQA_CloseAudio(handle);
     } else {
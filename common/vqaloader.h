@@ -190,6 +190,11 @@ typedef struct _VQAData
     int StartTime;
     int EndTime;
     int MemUsed;
+    unsigned ReadTime;           // Microseconds spent waiting on stream reads.
+    unsigned MaxFrameReadTime;   // Longest wait on stream reads while loading one frame.
+    unsigned DecodeTime;         // Microseconds spent unpacking codebooks, pointers and palettes.
+    unsigned MaxFrameDecodeTime; // Longest unpack of one frame.
+    int ReadStalls;              // Reads that had to wait for the read ahead thread.
 } VQAData;
 
 #pragma pack(push, 1)
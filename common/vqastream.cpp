@@ -0,0 +1,280 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "vqastream.h"
+#include "endianness.h"
+#include "vqaconfig.h"
+#include "vqafile.h"
+#include "vqaloader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct _VQAStream
+{
+    StreamHandlerFuncPtr Handler; // Client stream handler that does the actual reading.
+    std::thread Thread;
+    std::mutex Mutex;
+    std::mutex HandlerMutex; // Held for every call into the client stream handler, which isn't thread safe.
+    std::condition_variable Filled;  // Signalled when data is queued or the I/O thread finishes.
+    std::condition_variable Drained; // Signalled when queue space frees up or a stop is requested.
+    uint8_t* Queue;
+    uint8_t* Block; // I/O thread's read buffer, only touched by the I/O thread.
+    unsigned Capacity;
+    unsigned Head;
+    unsigned Count;
+    bool Stop;
+    bool Finished; // The I/O thread reached the end of the stream.
+};
+
+unsigned VQA_GetMicroseconds()
+{
+    using namespace std::chrono;
+    return (unsigned)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+**	Calls the client stream handler, only ever from one thread at a time. The I/O
+**	thread doesn't hold Mutex while reading, so the loader can still take data off
+**	the queue meanwhile.
+*/
+static long VQA_Stream_Call(VQAHandle* handle, long action, void* buffer, long nbytes)
+{
+    VQAStream* stream = handle->Stream;
+    std::lock_guard<std::mutex> lock(stream->HandlerMutex);
+
+    return stream->Handler(handle, action, buffer, nbytes);
+}
+
+/*
+**	Reads whole top level IFF chunks so a short read at the end of the file is
+**	never requested, client handlers can't report how much of a short read
+**	succeeded.
+*/
+static void VQA_Stream_Thread(VQAHandle* handle)
+{
+    VQAStream* stream = handle->Stream;
+    unsigned remaining = 0;
+
+    for (;;) {
+        unsigned size = remaining == 0 ? sizeof(VQAChunkHeader) : std::min<unsigned>(remaining, VQA_STREAM_BLOCK_SIZE);
+
+        {
+            std::unique_lock<std::mutex> lock(stream->Mutex);
+            stream->Drained.wait(lock, [&] { return stream->Stop || stream->Capacity - stream->Count >= size; });
+
+            if (stream->Stop) {
+                return;
+            }
+        }
+
+        if (VQA_Stream_Call(handle, VQACMD_READ, stream->Block, size)) {
+            std::lock_guard<std::mutex> lock(stream->Mutex);
+            stream->Finished = true;
+            stream->Filled.notify_all();
+            return;
+        }
+
+        if (remaining == 0) {
+            VQAChunkHeader* chunk = reinterpret_cast<VQAChunkHeader*>(stream->Block);
+            remaining = (be32toh(chunk->Size) + 1) & ~1;
+        } else {
+            remaining -= size;
+        }
+
+        std::lock_guard<std::mutex> lock(stream->Mutex);
+        unsigned tail = (stream->Head + stream->Count) % stream->Capacity;
+        unsigned first = std::min(size, stream->Capacity - tail);
+
+        memcpy(&stream->Queue[tail], stream->Block, first);
+        memcpy(stream->Queue, &stream->Block[first], size - first);
+        stream->Count += size;
+        stream->Filled.notify_all();
+    }
+}
+
+static void VQA_Stream_Halt(VQAStream* stream)
+{
+    if (stream->Thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(stream->Mutex);
+            stream->Stop = true;
+        }
+
+        stream->Drained.notify_all();
+        stream->Thread.join();
+    }
+}
+
+static void VQA_Stream_Resume(VQAHandle* handle)
+{
+    VQAStream* stream = handle->Stream;
+
+    stream->Head = 0;
+    stream->Count = 0;
+    stream->Stop = false;
+    stream->Finished = false;
+    stream->Thread = std::thread(VQA_Stream_Thread, handle);
+}
+
+/*
+**	Serves a read, or a forward seek when buffer is null, from the read ahead
+**	queue.
+*/
+static long VQA_Stream_Read(VQAHandle* handle, void* buffer, long nbytes)
+{
+    VQAStream* stream = handle->Stream;
+    VQAData* data = handle->VQABuf;
+    unsigned start = VQA_GetMicroseconds();
+    long error = 0;
+
+    if (stream->Queue == nullptr) {
+        if (buffer != nullptr) {
+            error = VQA_Stream_Call(handle, VQACMD_READ, buffer, nbytes);
+        } else {
+            error = VQA_Stream_Call(handle, VQACMD_SEEK, (void*)SEEK_CUR, nbytes);
+        }
+    } else {
+        uint8_t* dest = static_cast<uint8_t*>(buffer);
+        std::unique_lock<std::mutex> lock(stream->Mutex);
+
+        while (nbytes > 0) {
+            if (stream->Count == 0) {
+                if (stream->Finished) {
+                    error = 1;
+                    break;
+                }
+
+                ++data->ReadStalls;
+                stream->Filled.wait(lock, [&] { return stream->Count > 0 || stream->Finished; });
+                continue;
+            }
+
+            unsigned size = std::min(std::min<unsigned>(nbytes, stream->Count), stream->Capacity - stream->Head);
+
+            if (dest != nullptr) {
+                memcpy(dest, &stream->Queue[stream->Head], size);
+                dest += size;
+            }
+
+            stream->Head = (stream->Head + size) % stream->Capacity;
+            stream->Count -= size;
+            nbytes -= size;
+            stream->Drained.notify_one();
+        }
+    }
+
+    data->ReadTime += VQA_GetMicroseconds() - start;
+
+    return error;
+}
+
+static long VQA_Stream_Handler(VQAHandle* handle, long action, void* buffer, long nbytes)
+{
+    VQAStream* stream = handle->Stream;
+
+    switch (action) {
+    case VQACMD_READ:
+        return VQA_Stream_Read(handle, buffer, nbytes);
+
+    case VQACMD_SEEK:
+        if (buffer == (void*)SEEK_CUR && nbytes >= 0) {
+            return VQA_Stream_Read(handle, nullptr, nbytes);
+        }
+
+        // Any other seek moves the client stream, so restart reading ahead from the new position.
+        if (stream->Queue != nullptr) {
+            long error;
+
+            VQA_Stream_Halt(stream);
+
+            if (buffer == (void*)SEEK_CUR) {
+                error = VQA_Stream_Call(handle, action, buffer, nbytes - (long)stream->Count);
+            } else {
+                error = VQA_Stream_Call(handle, action, buffer, nbytes);
+            }
+
+            VQA_Stream_Resume(handle);
+
+            return error;
+        }
+
+        break;
+
+    default:
+        break;
+    }
+
+    return VQA_Stream_Call(handle, action, buffer, nbytes);
+}
+
+int VQA_StartStream(VQAHandle* handle)
+{
+    if (handle->Stream != nullptr) {
+        return VQAERR_NONE;
+    }
+
+    VQAStream* stream = new VQAStream;
+
+    stream->Handler = handle->StreamHandler;
+    stream->Queue = nullptr;
+    stream->Block = nullptr;
+    stream->Capacity = 0;
+    stream->Head = 0;
+    stream->Count = 0;
+    stream->Stop = false;
+    stream->Finished = false;
+
+    handle->Stream = stream;
+    handle->StreamHandler = VQA_Stream_Handler;
+
+    if (handle->Config.NumReadAheadBufs > 0) {
+        stream->Capacity = handle->Config.NumReadAheadBufs * VQA_STREAM_BLOCK_SIZE;
+        stream->Queue = (uint8_t*)malloc(stream->Capacity);
+        stream->Block = (uint8_t*)malloc(VQA_STREAM_BLOCK_SIZE);
+
+        // Without the buffers we just fall back to reading on the calling thread.
+        if (stream->Queue == nullptr || stream->Block == nullptr) {
+            free(stream->Queue);
+            free(stream->Block);
+            stream->Queue = nullptr;
+            stream->Block = nullptr;
+        } else {
+            handle->VQABuf->MemUsed += stream->Capacity + VQA_STREAM_BLOCK_SIZE;
+            VQA_Stream_Resume(handle);
+        }
+    }
+
+    return VQAERR_NONE;
+}
+
+void VQA_StopStream(VQAHandle* handle)
+{
+    VQAStream* stream = handle->Stream;
+
+    if (stream == nullptr) {
+        return;
+    }
+
+    VQA_Stream_Halt(stream);
+
+    handle->StreamHandler = stream->Handler;
+    handle->Stream = nullptr;
+
+    free(stream->Queue);
+    free(stream->Block);
+    delete stream;
+}
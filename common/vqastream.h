@@ -0,0 +1,31 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef VQASTREAM_H
+#define VQASTREAM_H
+
+typedef struct _VQAHandle VQAHandle;
+
+// Largest single read passed to the client stream handler, some handlers truncate the size to 16 bits.
+#define VQA_STREAM_BLOCK_SIZE 32768
+
+/*
+**	Reads the frame chunks of an opened VQA ahead of the loader on a background
+**	thread. The client stream handler is wrapped so the loader keeps making the
+**	same calls, reads are served from the read ahead queue and only block when
+**	the I/O thread has fallen behind. Config.NumReadAheadBufs sets the queue
+**	depth in VQA_STREAM_BLOCK_SIZE blocks, zero reads on the calling thread.
+*/
+int VQA_StartStream(VQAHandle* handle);
+void VQA_StopStream(VQAHandle* handle);
+unsigned VQA_GetMicroseconds();
+
+#endif
@@ -119,8 +119,13 @@ VQAErrorType VQA_Play(VQAHandle* handle, VQAPlayMode mode)
             if (data->Flags & VQA_DATA_FLAG_VIDEO_MEMORY_SET) {
                 ++VQAMovieDone;
             } else {
+                unsigned readtime = data->ReadTime;
                 rc = (VQAErrorType)VQA_LoadFrame(handle);
 
+                if (data->ReadTime - readtime > data->MaxFrameReadTime) {
+                    data->MaxFrameReadTime = data->ReadTime - readtime;
+                }
+
                 if (rc != VQAERR_NONE) {
                     if (rc != VQAERR_NOBUFFER && rc != VQAERR_SLEEPING) {
                         data->Flags |= VQA_DATA_FLAG_VIDEO_MEMORY_SET;
@@ -243,6 +248,11 @@ void VQA_GetStats(VQAHandle* handle, VQAStatistics* stats)
     stats->FramesSkipped = data->Drawer.NumSkipped;
     stats->MaxFrameSize = data->Loader.MaxFrameSize;
     stats->SamplesPlayed = data->Audio.SamplesPlayed;
+    stats->ReadTime = data->ReadTime;
+    stats->MaxReadTime = data->MaxFrameReadTime;
+    stats->DecodeTime = data->DecodeTime;
+    stats->MaxDecodeTime = data->MaxFrameDecodeTime;
+    stats->ReadStalls = data->ReadStalls;
 }
 
 // Function found in BR, appears its only use there is to force BH,BW and CM to 0;
@@ -32,6 +32,11 @@ typedef struct _VQAStatistics
     int MaxFrameSize;
     unsigned SamplesPlayed;
     unsigned MemUsed;
+    unsigned ReadTime;      // Microseconds spent waiting on file reads.
+    unsigned MaxReadTime;   // Longest wait on file reads for a single frame.
+    unsigned DecodeTime;    // Microseconds spent unpacking frame data.
+    unsigned MaxDecodeTime; // Longest unpack of a single frame.
+    int ReadStalls;         // Reads that had to wait for the read ahead thread.
 } VQAStatistics;
 
 typedef enum
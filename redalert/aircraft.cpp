@@ -4312,6 +4312,7 @@ bool AircraftClass::Edge_Of_World_AI(void)
         }
     } else {
         IsLocked = true;
+        HouseClass::Scan_Update(this);
     }
     return (false);
 }
@@ -1990,6 +1990,7 @@ int BuildingClass::Exit_Object(TechnoClass* base)
     **	will be considered as to have legally entered the visible map domain.
     */
     base->IsLocked = true;
+    HouseClass::Scan_Update(base);
 
     /*
     **	Find a good cell to unload the object to. The object, probably a vehicle
@@ -4477,6 +4478,7 @@ int BuildingClass::Mission_Missile(void)
                 IsReadyToCommence = false;
                 Status = LAUNCH_UP;
                 AnimToTrack = sput->As_Target();
+                Add_Referrer(AnimToTrack, As_Target());
             }
 #else
             IsReadyToCommence = false;
@@ -4484,6 +4486,7 @@ int BuildingClass::Mission_Missile(void)
             AnimClass* sput = new AnimClass(ANIM_SPUTDOOR, door);
             Status = LAUNCH_UP;
             AnimToTrack = sput->As_Target();
+            Add_Referrer(AnimToTrack, As_Target());
             return (1);
 #endif
         }
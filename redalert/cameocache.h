@@ -0,0 +1,96 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef CAMEOCACHE_H
+#define CAMEOCACHE_H
+
+#include <stddef.h>
+#include <string.h>
+
+/*
+**	Everything that decides how a visible sidebar slot looks: the cameo, where it goes
+**	and what is drawn over it. Slots are only drawn again when this changes.
+*/
+typedef struct CameoStateType
+{
+    void const* Shape;
+    int ShapeNum;
+    void const* Remap;
+    int X, Y;       // Window relative position of the slot.
+    int Stage;      // Construction clock stage while building.
+    bool IsDark;    // Unavailable, so darkened over.
+    bool IsProducing;
+    bool IsCompleted;
+    bool IsHolding; // Production is on hold.
+} CameoStateType;
+
+/*
+**	What one side strip last drew in each of its slots, and the page it drew them on.
+**	Each strip keeps its own, since the strips are drawn one after the other and a page
+**	flip seen by the first must still be seen by the second.
+*/
+template <int SLOTS> class CameoCacheClass
+{
+public:
+    CameoCacheClass(void)
+        : Page(NULL)
+    {
+        Forget();
+    }
+
+    /*
+    **	Nothing is known to be on the page, so every slot is drawn next time.
+    */
+    void Forget(void)
+    {
+        memset(IsDrawn, 0, sizeof(IsDrawn));
+    }
+
+    /*
+    **	Works out which of the first "count" slots to draw onto "page" and takes them as
+    **	drawn. Every slot is drawn when "force" is set or the page differs from last time;
+    **	"shared" says the slots share one background, so one changing draws them all.
+    **	Slots past "count" are off the page afterwards. Returns true if every slot is
+    **	to be drawn.
+    */
+    bool Update(CameoStateType const* state, int count, void const* page, bool force, bool shared, bool* draw)
+    {
+        bool any = false;
+        for (int i = 0; i < count; i++) {
+            draw[i] = !IsDrawn[i] || memcmp(&state[i], &State[i], sizeof(state[i])) != 0;
+            any |= draw[i];
+        }
+
+        bool all = force || page != Page || (shared && any);
+        Page = page;
+
+        for (int i = 0; i < count; i++) {
+            if (all) {
+                draw[i] = true;
+            }
+            if (draw[i]) {
+                memcpy(&State[i], &state[i], sizeof(state[i]));
+                IsDrawn[i] = true;
+            }
+        }
+        for (int i = count; i < SLOTS; i++) {
+            IsDrawn[i] = false;
+        }
+        return all;
+    }
+
+private:
+    CameoStateType State[SLOTS];
+    bool IsDrawn[SLOTS];
+    void const* Page;
+};
+
+#endif
@@ -58,6 +58,8 @@
  *   CellClass::Is_Bridge_Here -- Checks to see if this is a bridge occupied cell.             *
  *   CellClass::Is_Clear_To_Build -- Determines if cell can be built upon.                     *
  *   CellClass::Is_Clear_To_Move -- Determines if the cell is generally clear for travel       *
+ *   CellClass::Is_Clear_To_Move -- Checks passability of a cell from the packed arrays alone. *
+ *   CellClass::Is_Tiberium_In -- Checks if there could be Tiberium in a rectangle of cells.   *
  *   CellClass::Occupy_Down -- Flag occupation of specified cell.                              *
  *   CellClass::Occupy_Up -- Removes occupation flag from the specified cell.                  *
  *   CellClass::Overlap_Down -- This routine is used to mark a cell as being spilled over (over*
@@ -65,6 +67,7 @@
  *   CellClass::Overlap_Up -- Removes overlap flag for the cell.                               *
  *   CellClass::Read -- Reads a particular cell value from a save game file.                   *
  *   CellClass::Recalc_Attributes -- Recalculates the ground type attributes for the cell.     *
+ *   CellClass::Recalc_Occupant_Types -- Rebuilds the record of object types in the cell.      *
  *   CellClass::Redraw_Objects -- Redraws all objects overlapping this cell.                   *
  *   CellClass::Reduce_Tiberium -- Reduces the tiberium in the cell by the amount specified.   *
  *   CellClass::Reduce_Wall -- Damages a wall, if damage is high enough.                       *
@@ -72,12 +75,16 @@
  *   CellClass::Shimmer -- Causes all objects in the cell to shimmer.                          *
  *   CellClass::Spot_Index -- returns cell sub-coord index for given COORDINATE                *
  *   CellClass::Spread_Tiberium -- Spread Tiberium from this cell to an adjacent cell.         *
+ *   CellClass::Sync_Hot -- Copies the hot fields of the cell into the packed arrays.          *
+ *   CellClass::Sync_Land -- Copies the land type into HotLand and counts Tiberium blocks.     *
+ *   CellClass::Sync_Overlay -- Copies the wall state of the overlay into HotWall.             *
  *   CellClass::Tiberium_Adjust -- Adjust the look of the Tiberium for smooth.                 *
  *   CellClass::Wall_Update -- Updates the imagery for wall objects in cell.                   *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
 #include "vortex.h"
+#include "keyframe.h"
 
 /*
 ** New sidebar for GlyphX multiplayer. ST - 8/2/2019 2:50PM
@@ -85,6 +92,12 @@
 #include "sidebarglyphx.h"
 #include "utracker.h"
 
+unsigned char CellClass::HotLand[MAP_CELL_TOTAL];
+unsigned char CellClass::HotOccupy[MAP_CELL_TOTAL];
+unsigned char CellClass::HotZones[MZONE_COUNT][MAP_CELL_TOTAL];
+unsigned char CellClass::HotWall[MAP_CELL_TOTAL];
+unsigned char CellClass::TiberiumBlocks[TIBERIUM_BLOCK_W * TIBERIUM_BLOCK_H];
+
 /***********************************************************************************************
  * CellClass::CellClass -- Constructor for cell objects.                                       *
  *                                                                                             *
@@ -127,6 +140,7 @@ CellClass::CellClass(void)
     , IsMappedByPlayerMask(0)
     , IsVisibleByPlayerMask(0)
     , CTFFlag(NULL)
+    , OccupantTypes(0)
 {
     for (int zone = MZONE_FIRST; zone < MZONE_COUNT; zone++) {
         Zones[zone] = 0;
@@ -209,6 +223,11 @@ TechnoClass* CellClass::Cell_Techno(int x, int y) const
     */
     click = XY_Coord(Pixel_To_Lepton(x), Pixel_To_Lepton(y));
 
+    if (!Has_Occupant(RTTI_AIRCRAFT) && !Has_Occupant(RTTI_BUILDING) && !Has_Occupant(RTTI_INFANTRY)
+        && !Has_Occupant(RTTI_UNIT) && !Has_Occupant(RTTI_VESSEL)) {
+        return (NULL);
+    }
+
     if (Cell_Occupier()) {
         object = Cell_Occupier();
         while (object && object->IsActive) {
@@ -244,6 +263,10 @@ ObjectClass* CellClass::Cell_Find_Object(RTTIType rtti) const
     assert((unsigned)Cell_Number() <= MAP_CELL_TOTAL);
     assert(rtti != RTTI_NONE);
 
+    if (!Has_Occupant(rtti)) {
+        return (NULL);
+    }
+
     ObjectClass* object = Cell_Occupier();
 
     while (object != NULL && object->IsActive) {
@@ -535,40 +558,38 @@ void CellClass::Recalc_Attributes(void)
 {
     assert((unsigned)Cell_Number() <= MAP_CELL_TOTAL);
 
-    /*
-    **	Special override for interior terrain set so that a non-template or a clear template
-    **	is equivalent to impassable rock.
-    */
-    if (LastTheater == THEATER_INTERIOR) {
-        if (TType == TEMPLATE_NONE || TType == TEMPLATE_CLEAR1) {
-            Land = LAND_ROCK;
-            return;
-        }
-    }
+    if (LastTheater == THEATER_INTERIOR && (TType == TEMPLATE_NONE || TType == TEMPLATE_CLEAR1)) {
 
-    /*
-    **	Check for wall effects.
-    */
-    if (Overlay != OVERLAY_NONE) {
+        /*
+        **	Special override for interior terrain set so that a non-template or a clear template
+        **	is equivalent to impassable rock.
+        */
+        Land = LAND_ROCK;
+
+    } else if (Overlay != OVERLAY_NONE && OverlayTypeClass::As_Reference(Overlay).Land != LAND_CLEAR) {
+
+        /*
+        **	Check for wall effects.
+        */
         Land = OverlayTypeClass::As_Reference(Overlay).Land;
-        if (Land != LAND_CLEAR)
-            return;
-    }
 
-    /*
-    **	If there is a template associated with this cell, then fetch the
-    **	land type given the template type and icon number.
-    */
-    if (TType != TEMPLATE_NONE && TType != 255) {
+    } else if (TType != TEMPLATE_NONE && TType != 255) {
+
+        /*
+        **	If there is a template associated with this cell, then fetch the
+        **	land type given the template type and icon number.
+        */
         TemplateTypeClass const* ttype = &TemplateTypeClass::As_Reference(TType);
         Land = ttype->Land_Type(TIcon);
-        return;
-    }
 
-    /*
-    **	No template is the same as clear terrain.
-    */
-    Land = LAND_CLEAR;
+    } else {
+
+        /*
+        **	No template is the same as clear terrain.
+        */
+        Land = LAND_CLEAR;
+    }
+    Sync_Land();
 }
 
 /***********************************************************************************************
@@ -615,6 +636,7 @@ void CellClass::Occupy_Down(ObjectClass* object)
         object->Next = Cell_Occupier();
         OccupierPtr = object;
     }
+    OccupantTypes |= 1U << object->What_Am_I();
     Map.Radar_Pixel(Cell_Number());
 
     /*
@@ -661,6 +683,7 @@ void CellClass::Occupy_Down(ObjectClass* object)
     default:
         break;
     }
+    Sync_Occupy();
 }
 
 /***********************************************************************************************
@@ -706,6 +729,7 @@ void CellClass::Occupy_Up(ObjectClass* object)
         }
         //		assert(found);
     }
+    Recalc_Occupant_Types();
     Map.Radar_Pixel(Cell_Number());
 
     /*
@@ -729,6 +753,153 @@ void CellClass::Occupy_Up(ObjectClass* object)
     default:
         break;
     }
+    Sync_Occupy();
+}
+
+/***********************************************************************************************
+ * CellClass::Recalc_Occupant_Types -- Rebuilds the record of object types in the cell.        *
+ *                                                                                             *
+ *    The typed lookups (Cell_Find_Object and friends) skip walking the occupier chain when    *
+ *    the cell holds nothing of the requested type. This rebuilds the bits they check from     *
+ *    the chain itself. It is done when an object leaves the cell, since another of the same   *
+ *    type may remain, and for every cell once a saved game has been loaded.                   *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   The objects in the chain must have their pointers decoded.                      *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CellClass::Recalc_Occupant_Types(void)
+{
+    OccupantTypes = 0;
+    for (ObjectClass* optr = Cell_Occupier(); optr != NULL; optr = optr->Next) {
+        OccupantTypes |= 1U << optr->What_Am_I();
+    }
+}
+
+/***********************************************************************************************
+ * CellClass::Sync_Hot -- Copies the hot fields of the cell into the packed arrays.            *
+ *                                                                                             *
+ *    The packed copies are normally kept up to date by whatever changes the fields. This      *
+ *    sets them all at once for a cell that has just been constructed or read from a saved     *
+ *    game.                                                                                    *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   The cell must be in the map array, since its ID is the index used.             *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CellClass::Sync_Hot(void)
+{
+    assert((unsigned)Cell_Number() < MAP_CELL_TOTAL);
+
+    Sync_Land();
+    Sync_Overlay();
+    HotOccupy[ID] = Flag.Composite;
+    for (int zone = MZONE_FIRST; zone < MZONE_COUNT; zone++) {
+        HotZones[zone][ID] = Zones[zone];
+    }
+}
+
+/***********************************************************************************************
+ * CellClass::Sync_Overlay -- Copies the wall state of the overlay into HotWall.               *
+ *                                                                                             *
+ *    Called wherever the overlay of the cell is changed, so the passability checks can tell   *
+ *    whether there is a wall here, and whether it can be crushed, without the cell.           *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CellClass::Sync_Overlay(void)
+{
+    unsigned char wall = 0;
+
+    if (Overlay != OVERLAY_NONE) {
+        OverlayTypeClass const& overlay = OverlayTypeClass::As_Reference(Overlay);
+        if (overlay.IsWall) {
+            wall = HOTWALL_WALL;
+            if (overlay.IsCrushable) {
+                wall |= HOTWALL_CRUSHABLE;
+            }
+        }
+    }
+    HotWall[ID] = wall;
+}
+
+/***********************************************************************************************
+ * CellClass::Sync_Land -- Copies the land type into HotLand and counts Tiberium blocks.       *
+ *                                                                                             *
+ *    Whenever the land type of the cell may have changed, this records it in HotLand. If      *
+ *    that turns the cell into or out of Tiberium, the count for its map block is adjusted.    *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   HotLand must only be written through here, or the block counts go wrong.        *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CellClass::Sync_Land(void)
+{
+    LandType land = Land_Type();
+    bool was = (HotLand[ID] == LAND_TIBERIUM);
+    bool is = (land == LAND_TIBERIUM);
+
+    if (was != is) {
+        int block = (Cell_Y(ID) >> TIBERIUM_BLOCK_SHIFT) * TIBERIUM_BLOCK_W + (Cell_X(ID) >> TIBERIUM_BLOCK_SHIFT);
+        if (is) {
+            TiberiumBlocks[block]++;
+        } else {
+            TiberiumBlocks[block]--;
+        }
+    }
+    HotLand[ID] = land;
+}
+
+/***********************************************************************************************
+ * CellClass::Is_Tiberium_In -- Checks if there could be Tiberium in a rectangle of cells.     *
+ *                                                                                             *
+ *    This looks at the Tiberium counts of the map blocks that the rectangle touches. A false  *
+ *    result means that no cell in the rectangle has Tiberium land. A true result only means   *
+ *    that one of the blocks has some, possibly outside the rectangle.                         *
+ *                                                                                             *
+ * INPUT:   x1,y1 -- Cell coordinates of the upper left corner of the rectangle.               *
+ *                                                                                             *
+ *          x2,y2 -- Cell coordinates of the lower right corner (inclusive).                   *
+ *                                                                                             *
+ * OUTPUT:  bool; Could there be Tiberium in the rectangle?                                    *
+ *                                                                                             *
+ * WARNINGS:   Parts of the rectangle off the map are ignored.                                 *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool CellClass::Is_Tiberium_In(int x1, int y1, int x2, int y2)
+{
+    x1 = max(x1, 0);
+    y1 = max(y1, 0);
+    x2 = min(x2, MAP_CELL_W - 1);
+    y2 = min(y2, MAP_CELL_H - 1);
+
+    for (int by = y1 >> TIBERIUM_BLOCK_SHIFT; by <= y2 >> TIBERIUM_BLOCK_SHIFT; by++) {
+        for (int bx = x1 >> TIBERIUM_BLOCK_SHIFT; bx <= x2 >> TIBERIUM_BLOCK_SHIFT; bx++) {
+            if (TiberiumBlocks[by * TIBERIUM_BLOCK_W + bx] != 0) {
+                return (true);
+            }
+        }
+    }
+    return (false);
 }
 
 /***********************************************************************************************
@@ -992,6 +1163,172 @@ bool CellClass::Get_Template_Info(char* template_name, int& icon, void*& image_d
     return false;
 }
 
+/*
+**	The terrain under a cell -- its template icon, smudge and overlay -- seldom
+**	changes, but is redrawn every time anything moves over the cell. The finished
+**	composite of those layers is kept in a cache surface of CELL_PIXEL_W by
+**	CELL_PIXEL_H slots, one per cell of a TERRAIN_CACHE_CELLS square block of the
+**	map, so any view up to that size never has two visible cells sharing a slot.
+**	Each slot records what it was built from; a cell whose overlay, smudge or
+**	template changes simply no longer matches its slot and is rebuilt the next
+**	time it is drawn. Only cells whose layers stay inside the cell and whose
+**	template icon is opaque are cached, so the output is unchanged.
+*/
+#define TERRAIN_CACHE_CELLS 64
+
+typedef struct
+{
+    bool IsValid;
+    CELL Cell;
+    TemplateTypeClass const* Template;
+    int Icon;
+    SmudgeType Smudge;
+    unsigned char SmudgeData;
+    OverlayType Overlay;
+    unsigned char OverlayData;
+    TheaterType Theater;
+} TerrainCacheType;
+
+static GraphicBufferClass* _TerrainCache = NULL;
+static TerrainCacheType _TerrainCacheSlot[TERRAIN_CACHE_CELLS * TERRAIN_CACHE_CELLS];
+
+static bool _Fits_In_Cell(void const* shapefile)
+{
+    return (shapefile == NULL
+            || (Get_Build_Frame_Width(shapefile) <= CELL_PIXEL_W && Get_Build_Frame_Height(shapefile) <= CELL_PIXEL_H));
+}
+
+static void _Draw_Terrain_Layers(CellClass const& cell, TemplateTypeClass const* ttype, int icon, int x, int y)
+{
+    /*
+    **	This is the underlying terrain icon.
+    */
+    if (ttype->Get_Image_Data()) {
+        LogicPage->Draw_Stamp(ttype->Get_Image_Data(), icon, x, y, NULL, WINDOW_TACTICAL);
+    }
+
+    /*
+    **	Redraw any smudge.
+    */
+    if (cell.Smudge != SMUDGE_NONE) {
+        SmudgeTypeClass::As_Reference(cell.Smudge).Draw_It(x, y, cell.SmudgeData);
+    }
+
+    /*
+    **	Draw the overlay object.
+    */
+    if (cell.Overlay != OVERLAY_NONE) {
+        OverlayTypeClass const& otype = OverlayTypeClass::As_Reference(cell.Overlay);
+        IsTheaterShape = (bool)otype.IsTheater; // Tell Build_Frame if this overlay is theater specific
+        CC_Draw_Shape(otype.Get_Image_Data(),
+                      cell.OverlayData,
+                      (x + (CELL_PIXEL_W >> 1)),
+                      (y + (CELL_PIXEL_H >> 1)),
+                      WINDOW_TACTICAL,
+                      SHAPE_CENTER | SHAPE_WIN_REL | SHAPE_GHOST,
+                      NULL,
+                      DisplayClass::UnitShadow);
+        IsTheaterShape = false;
+    }
+}
+
+/*
+**	Draws the terrain layers of the cell from the cache, building its slot first
+**	if needed. Returns false if the cell can't be cached and must be drawn the
+**	normal way.
+*/
+static bool _Draw_Cached_Terrain(CellClass const& cell, TemplateTypeClass const* ttype, int icon, int x, int y)
+{
+    IconsetClass const* iconset = (IconsetClass const*)ttype->Get_Image_Data();
+    if (iconset == NULL) {
+        return (false);
+    }
+
+    int index = iconset->Map_Data()[icon];
+    if (index >= iconset->Icon_Count() || iconset->Trans_Data()[index]) {
+        return (false);
+    }
+    if (cell.Smudge != SMUDGE_NONE && !_Fits_In_Cell(SmudgeTypeClass::As_Reference(cell.Smudge).Get_Image_Data())) {
+        return (false);
+    }
+    if (cell.Overlay != OVERLAY_NONE && !_Fits_In_Cell(OverlayTypeClass::As_Reference(cell.Overlay).Get_Image_Data())) {
+        return (false);
+    }
+
+    if (_TerrainCache == NULL) {
+        _TerrainCache = new GraphicBufferClass(TERRAIN_CACHE_CELLS * CELL_PIXEL_W, TERRAIN_CACHE_CELLS * CELL_PIXEL_H);
+    }
+
+    CELL cellnum = cell.Cell_Number();
+    int slotx = Cell_X(cellnum) % TERRAIN_CACHE_CELLS;
+    int sloty = Cell_Y(cellnum) % TERRAIN_CACHE_CELLS;
+    int sx = slotx * CELL_PIXEL_W;
+    int sy = sloty * CELL_PIXEL_H;
+    TerrainCacheType& slot = _TerrainCacheSlot[sloty * TERRAIN_CACHE_CELLS + slotx];
+
+    if (!slot.IsValid || slot.Cell != cellnum || slot.Template != ttype || slot.Icon != icon
+        || slot.Smudge != cell.Smudge || slot.SmudgeData != cell.SmudgeData || slot.Overlay != cell.Overlay
+        || slot.OverlayData != cell.OverlayData || slot.Theater != Scen.Theater) {
+
+        /*
+        **	Render the layers into the slot by pointing the tactical window at it.
+        */
+        int window[4];
+        memcpy(window, WindowList[WINDOW_TACTICAL], sizeof(window));
+        WindowList[WINDOW_TACTICAL][WINDOWX] = sx;
+        WindowList[WINDOW_TACTICAL][WINDOWY] = sy;
+        WindowList[WINDOW_TACTICAL][WINDOWWIDTH] = CELL_PIXEL_W;
+        WindowList[WINDOW_TACTICAL][WINDOWHEIGHT] = CELL_PIXEL_H;
+        GraphicViewPortClass* oldpage = Set_Logic_Page(_TerrainCache);
+
+        _Draw_Terrain_Layers(cell, ttype, icon, 0, 0);
+
+        Set_Logic_Page(oldpage);
+        memcpy(WindowList[WINDOW_TACTICAL], window, sizeof(window));
+
+        slot.IsValid = true;
+        slot.Cell = cellnum;
+        slot.Template = ttype;
+        slot.Icon = icon;
+        slot.Smudge = cell.Smudge;
+        slot.SmudgeData = cell.SmudgeData;
+        slot.Overlay = cell.Overlay;
+        slot.OverlayData = cell.OverlayData;
+        slot.Theater = Scen.Theater;
+    }
+
+    /*
+    **	Copy the slot to the cell's position, clipped to the tactical window.
+    */
+    int winx = WindowList[WINDOW_TACTICAL][WINDOWX];
+    int winy = WindowList[WINDOW_TACTICAL][WINDOWY];
+    int dx = winx + x;
+    int dy = winy + y;
+    int w = CELL_PIXEL_W;
+    int h = CELL_PIXEL_H;
+
+    if (dx < winx) {
+        sx += winx - dx;
+        w -= winx - dx;
+        dx = winx;
+    }
+    if (dy < winy) {
+        sy += winy - dy;
+        h -= winy - dy;
+        dy = winy;
+    }
+    if (dx + w > winx + WindowList[WINDOW_TACTICAL][WINDOWWIDTH]) {
+        w = winx + WindowList[WINDOW_TACTICAL][WINDOWWIDTH] - dx;
+    }
+    if (dy + h > winy + WindowList[WINDOW_TACTICAL][WINDOWHEIGHT]) {
+        h = winy + WindowList[WINDOW_TACTICAL][WINDOWHEIGHT] - dy;
+    }
+    if (w > 0 && h > 0) {
+        _TerrainCache->Blit(*LogicPage, sx, sy, dx, dy, w, h);
+    }
+    return (true);
+}
+
 /***********************************************************************************************
  * CellClass::Draw_It -- Draws the cell imagery at the location specified.                     *
  *                                                                                             *
@@ -1094,10 +1431,22 @@ void CellClass::Draw_It(int x, int y, bool objects) const
             }
 #endif
 
+            /*
+            **	Use the terrain cache unless the terrain is to be remapped or the map
+            **	editor is going to draw between the layers.
+            */
+            bool cached = false;
+            if (remap == NULL) {
+#ifdef SCENARIO_EDITOR
+                if (!Debug_Map)
+#endif
+                    cached = _Draw_Cached_Terrain(*this, ttype, icon, x, y);
+            }
+
             /*
             **	This is the underlying terrain icon.
             */
-            if (ttype->Get_Image_Data()) {
+            if (!cached && ttype->Get_Image_Data()) {
                 LogicPage->Draw_Stamp(ttype->Get_Image_Data(), icon, x, y, NULL, WINDOW_TACTICAL);
                 if (remap) {
                     LogicPage->Remap(x + Map.TacPixelX, y + Map.TacPixelY, ICON_PIXEL_W, ICON_PIXEL_H, remap);
@@ -1123,14 +1472,14 @@ void CellClass::Draw_It(int x, int y, bool objects) const
             /*
             **	Redraw any smudge.
             */
-            if (Smudge != SMUDGE_NONE) {
+            if (!cached && Smudge != SMUDGE_NONE) {
                 SmudgeTypeClass::As_Reference(Smudge).Draw_It(x, y, SmudgeData);
             }
 
             /*
             **	Draw the overlay object.
             */
-            if (Overlay != OVERLAY_NONE) {
+            if (!cached && Overlay != OVERLAY_NONE) {
                 OverlayTypeClass const& otype = OverlayTypeClass::As_Reference(Overlay);
                 IsTheaterShape = (bool)otype.IsTheater; // Tell Build_Frame if this overlay is theater specific
                 CC_Draw_Shape(otype.Get_Image_Data(),
@@ -1657,26 +2006,31 @@ void CellClass::Wall_Update(void)
             */
             if (newcell->Overlay == OVERLAY_BRICK_WALL && newcell->OverlayData == 48) {
                 newcell->Overlay = OVERLAY_NONE;
+                newcell->Sync_Overlay();
                 newcell->OverlayData = 0;
                 Detach_This_From_All(::As_Target(newcell->Cell_Number()), true);
             }
             if (newcell->Overlay == OVERLAY_SANDBAG_WALL && newcell->OverlayData == 16) {
                 newcell->Overlay = OVERLAY_NONE;
+                newcell->Sync_Overlay();
                 newcell->OverlayData = 0;
                 Detach_This_From_All(::As_Target(newcell->Cell_Number()), true);
             }
             if (newcell->Overlay == OVERLAY_CYCLONE_WALL && newcell->OverlayData == 32) {
                 newcell->Overlay = OVERLAY_NONE;
+                newcell->Sync_Overlay();
                 newcell->OverlayData = 0;
                 Detach_This_From_All(::As_Target(newcell->Cell_Number()), true);
             }
             if (newcell->Overlay == OVERLAY_FENCE && (newcell->OverlayData == 16 || newcell->OverlayData == 32)) {
                 newcell->Overlay = OVERLAY_NONE;
+                newcell->Sync_Overlay();
                 newcell->OverlayData = 0;
                 Detach_This_From_All(::As_Target(newcell->Cell_Number()), true);
             }
             if (newcell->Overlay == OVERLAY_BARBWIRE_WALL && newcell->OverlayData == 16) {
                 newcell->Overlay = OVERLAY_NONE;
+                newcell->Sync_Overlay();
                 newcell->OverlayData = 0;
                 Detach_This_From_All(::As_Target(newcell->Cell_Number()), true);
             }
@@ -1735,6 +2089,7 @@ int CellClass::Reduce_Tiberium(int levels)
             reducer = levels;
         } else {
             Overlay = OVERLAY_NONE;
+            Sync_Overlay();
             reducer = OverlayData;
             OverlayData = 0;
             Recalc_Attributes();
@@ -1792,6 +2147,7 @@ int CellClass::Reduce_Wall(int damage)
 
                     Owner = HOUSE_NONE;
                     Overlay = OVERLAY_NONE;
+                    Sync_Overlay();
                     OverlayData = 0;
                     Recalc_Attributes();
                     Redraw_Objects();
@@ -2140,6 +2496,7 @@ long CellClass::Tiberium_Adjust(bool pregame)
                 case OVERLAY_GOLD4:
                     value = Rule.GoldValue;
                     Overlay = Random_Pick(OVERLAY_GOLD1, OVERLAY_GOLD4);
+                    Sync_Overlay();
                     break;
 
                 case OVERLAY_GEMS1:
@@ -2149,6 +2506,7 @@ long CellClass::Tiberium_Adjust(bool pregame)
                     gems = true;
                     value = Rule.GemValue * 4;
                     Overlay = Random_Pick(OVERLAY_GEMS1, OVERLAY_GEMS4);
+                    Sync_Overlay();
                     break;
 
                 default:
@@ -2944,6 +3302,44 @@ bool CellClass::Is_Clear_To_Move(SpeedType loco,
 {
     assert((unsigned)Cell_Number() <= MAP_CELL_TOTAL);
 
+    return (Is_Clear_To_Move(ID, loco, ignoreinfantry, ignorevehicles, zone, check));
+}
+
+/***********************************************************************************************
+ * CellClass::Is_Clear_To_Move -- Checks passability of a cell from the packed arrays alone.   *
+ *                                                                                             *
+ *    This is the same check as the member function, for callers that only have the cell      *
+ *    number. It reads nothing but the packed copies of the cell fields, so scans over many    *
+ *    cells, such as the zone fill, never touch the cells themselves.                          *
+ *                                                                                             *
+ * INPUT:   cell     -- The cell to check.                                                     *
+ *                                                                                             *
+ *          loco     -- The locomotion type to use when determining passablility.              *
+ *                                                                                             *
+ *          ignoreinfantry -- Should infantry in the cell be ignored for movement purposes?    *
+ *                                                                                             *
+ *          ignorevehicles -- If vehicles should be ignored, then this flag will be true.      *
+ *                                                                                             *
+ *          zone     -- If specified, the zone must match this value or else movement is       *
+ *                      presumed disallowed.                                                   *
+ *                                                                                             *
+ *          check    -- This specifies the zone type that this check applies to.               *
+ *                                                                                             *
+ * OUTPUT:  Is the cell generally passable to ground targeting?                                *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool CellClass::Is_Clear_To_Move(CELL cell,
+                                 SpeedType loco,
+                                 bool ignoreinfantry,
+                                 bool ignorevehicles,
+                                 int zone,
+                                 MZoneType check)
+{
+    assert((unsigned)cell < MAP_CELL_TOTAL);
+
     /*
     **	Flying objects always consider every cell passable since they can fly over everything.
     */
@@ -2951,12 +3347,16 @@ bool CellClass::Is_Clear_To_Move(SpeedType loco,
         return (true);
     }
 
+    assert(HotZones[check][cell] == Map[cell].Zones[check]);
+    assert(HotOccupy[cell] == Map[cell].Flag.Composite);
+    assert(HotLand[cell] == Map[cell].Land_Type());
+
     /*
     **	If a zone was specified, then see if the cell is in a legal
     **	zone to allow movement.
     */
     if (zone != -1) {
-        if (zone != Zones[check]) {
+        if (zone != HotZones[check][cell]) {
             return (false);
         }
     }
@@ -2965,7 +3365,7 @@ bool CellClass::Is_Clear_To_Move(SpeedType loco,
     **	Check the occupy bits for passable legality. If ignore infantry is true, then
     **	don't consider infnatry.
     */
-    int composite = Flag.Composite;
+    int composite = HotOccupy[cell];
     if (ignoreinfantry) {
         composite &= 0xE0; // Drop the infantry occupation bits.
     }
@@ -2979,19 +3379,16 @@ bool CellClass::Is_Clear_To_Move(SpeedType loco,
     /*
     **	Fetch the land type of the cell -- to be modified and used later.
     */
-    LandType land = Land_Type();
+    LandType land = (LandType)HotLand[cell];
 
     /*
     **	Walls are always considered to block the terrain for general passability
     **	purposes unless this is a wall crushing check or if the checking object
     **	can destroy walls.
     */
-    OverlayTypeClass const* overlay = NULL;
-    if (Overlay != OVERLAY_NONE) {
-        overlay = &OverlayTypeClass::As_Reference(Overlay);
-    }
-    if (overlay != NULL && overlay->IsWall) {
-        if (check != MZONE_DESTROYER && (check != MZONE_CRUSHER || !overlay->IsCrushable)) {
+    int wall = HotWall[cell];
+    if (wall & HOTWALL_WALL) {
+        if (check != MZONE_DESTROYER && (check != MZONE_CRUSHER || !(wall & HOTWALL_CRUSHABLE))) {
             return (false);
         }
 
@@ -3004,7 +3401,8 @@ bool CellClass::Is_Clear_To_Move(SpeedType loco,
 
     /*
     **	See if the ground type is impassable to this locomotion type and if
-    **	so, return the error condition.
+    **	so, return the error condition. The Ground table is already packed by land and
+    **	speed type, so it is read as it is rather than keeping a copy for every cell.
     */
     if (::Ground[land].Cost[loco] == 0) {
         return (false);
@@ -3250,11 +3648,15 @@ bool CellClass::Can_Tiberium_Germinate(void) const
 void CellClass::Set_Mapped(HousesType house, bool set)
 {
     int shift = (int)house;
+    if (Is_Mapped(house) == set) {
+        return;
+    }
     if (set) {
         IsMappedByPlayerMask |= (1 << shift);
     } else {
         IsMappedByPlayerMask &= ~(1 << shift);
     }
+    DisplayClass::Update_Shadow_Index(Cell_Number(), house, set);
 }
 
 /***********************************************************************************************
@@ -3381,4 +3783,5 @@ bool CellClass::Is_Jamming(HouseClass* player) const
 void CellClass::Override_Land_Type(LandType type)
 {
     OverrideLand = type;
+    Sync_Land();
 }
@@ -47,6 +47,14 @@ class TerrainClass;
 class VesselClass;
 struct NoInitClass;
 
+/*
+**	The map is split into square blocks of this many cells a side (as a shift) for
+**	the count of Tiberium cells kept in CellClass::TiberiumBlocks.
+*/
+#define TIBERIUM_BLOCK_SHIFT 3
+#define TIBERIUM_BLOCK_W     (MAP_CELL_W >> TIBERIUM_BLOCK_SHIFT)
+#define TIBERIUM_BLOCK_H     (MAP_CELL_H >> TIBERIUM_BLOCK_SHIFT)
+
 /****************************************************************************
 **	Each cell on the map is controlled by the following structure.
 */
@@ -218,6 +226,29 @@ public:
         unsigned char Composite;
     } Flag;
 
+    /*
+    **	Copies of the fields that the zone and passability scans read for cell after
+    **	cell, packed by cell number so a scan touches a few bytes per cell instead of
+    **	a whole CellClass. Each copy is written wherever the field it mirrors is.
+    */
+    static unsigned char HotLand[MAP_CELL_TOTAL];               // Land_Type()
+    static unsigned char HotOccupy[MAP_CELL_TOTAL];             // Flag.Composite
+    static unsigned char HotZones[MZONE_COUNT][MAP_CELL_TOTAL]; // Zones[]
+    static unsigned char HotWall[MAP_CELL_TOTAL];               // HOTWALL_ bits of the Overlay
+
+    enum HotWallEnum
+    {
+        HOTWALL_WALL = 0x01,     // The overlay is a wall.
+        HOTWALL_CRUSHABLE = 0x02 // ...and it can be crushed.
+    };
+
+    /*
+    **	Number of cells in each map block whose HotLand is LAND_TIBERIUM. Kept up to
+    **	date with HotLand, so searches for ore can pass over empty parts of the map.
+    */
+    static unsigned char TiberiumBlocks[TIBERIUM_BLOCK_W * TIBERIUM_BLOCK_H];
+    static bool Is_Tiberium_In(int x1, int y1, int x2, int y2);
+
     //----------------------------------------------------------------
     CellClass(void);
     CellClass(NoInitClass const& x)
@@ -246,6 +277,22 @@ public:
         return (RTTI_CELL);
     }
     BuildingClass* Cell_Building(void) const;
+    bool Has_Occupant(RTTIType rtti) const
+    {
+        return ((OccupantTypes & (1U << rtti)) != 0);
+    }
+    void Recalc_Occupant_Types(void);
+    void Set_Zone(MZoneType check, unsigned char zone)
+    {
+        Zones[check] = zone;
+        HotZones[check][ID] = zone;
+    }
+    void Sync_Occupy(void)
+    {
+        HotOccupy[ID] = Flag.Composite;
+    }
+    void Sync_Overlay(void);
+    void Sync_Hot(void);
     CELL Cell_Number(void) const
     {
         return (ID);
@@ -288,6 +335,12 @@ public:
                           bool ignorevehicles,
                           int zone = -1,
                           MZoneType check = MZONE_NORMAL) const;
+    static bool Is_Clear_To_Move(CELL cell,
+                                 SpeedType loco,
+                                 bool ignoreinfantry,
+                                 bool ignorevehicles,
+                                 int zone = -1,
+                                 MZoneType check = MZONE_NORMAL);
     bool Is_Spot_Free(int spot_index) const
     {
         return (!(Flag.Composite & (1 << spot_index)));
@@ -367,6 +420,8 @@ public:
 private:
     CellClass(CellClass const&);
 
+    void Sync_Land(void);
+
     LandType Land; // The land type of this cell.
 
     LandType OverrideLand; // The overriden land type of this cell.
@@ -376,11 +431,18 @@ private:
      */
     AnimClass* CTFFlag;
 
+    /*
+    **	One bit for each RTTIType present in the occupier chain, so typed lookups can
+    **	tell that a cell holds nothing of that kind without walking the chain. It may
+    **	have extra bits set, but never misses a type that is there.
+    */
+    unsigned int OccupantTypes;
+
     /*
     ** Some additional padding in case we need to add data to the class and maintain backwards compatibility for
     *save/load
     */
-    unsigned char SaveLoadPadding[28];
+    unsigned char SaveLoadPadding[24];
 };
 
 #endif
\ No newline at end of file
@@ -43,6 +43,7 @@
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
+#include <limits.h>
 #include <stdio.h>
 //#include <mem.h>
 #include <sys/timeb.h>
@@ -177,8 +178,8 @@ void ConnectionClass::Init(void)
     NumSendNoAck = 0;
     NumSendAck = 0;
 
-    LastSeqID = 0xffffffff;
-    LastReadID = 0xffffffff;
+    LastSeqID = ULONG_MAX;
+    LastReadID = ULONG_MAX;
 
     Queue->Init();
 
@@ -342,7 +343,7 @@ int ConnectionClass::Receive_Packet(void* buf, int buflen)
         If this is a packet requires an ACK, and it's ID is older than our
         "oldest" ID, we know it's a resend; send an ACK, but don't queue it
         .....................................................................*/
-        if (packet->PacketID <= LastSeqID && LastSeqID != 0xffffffff) {
+        if (packet->PacketID <= LastSeqID && LastSeqID != ULONG_MAX) {
             save_packet = 0;
         }
 
@@ -87,6 +87,7 @@ TcpipManagerClass Winsock;
 
 #include "interpal.h"
 #include "vortex.h"
+#include "common/framearena.h"
 #include "common/framelimit.h"
 #include "common/vqatask.h"
 #include "common/vqaloader.h"
@@ -1802,7 +1803,7 @@ bool Main_Loop()
     **	Setup the timer so that the Main_Loop function processes at the correct rate.
     */
     if (Session.Type != GAME_NORMAL && Session.Type != GAME_SKIRMISH
-        && Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+        && Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
 
         //
         // In playback mode, run as fast as possible.
@@ -1887,7 +1888,9 @@ bool Main_Loop()
     /*
     **	Process all commands that are ready to be processed.
     */
+    Telemetry.Begin(TELEMETRY_QUEUE_AI);
     Queue_AI();
+    Telemetry.End(TELEMETRY_QUEUE_AI);
 
     /*
     **	Keep track of elapsed time in the game.
@@ -2016,7 +2019,15 @@ bool Main_Loop()
 #endif
     BEnd(BENCH_GAME_FRAME);
 
+    /*
+    **	Anything allocated from the frame arena during this frame is released.
+    */
+    FrameArenaClass::Thread().Reset();
+
+    Telemetry.Begin(TELEMETRY_SYNC_DELAY);
     Sync_Delay();
+    Telemetry.End(TELEMETRY_SYNC_DELAY);
+    Logic.Record_Telemetry();
     return (!GameActive);
 }
 
@@ -169,6 +169,7 @@ bool CrateClass::Get_Crate(CELL cell)
             || cellptr->Overlay == OVERLAY_WATER_CRATE) {
 
             cellptr->Overlay = OVERLAY_NONE;
+            cellptr->Sync_Overlay();
             cellptr->OverlayData = 0;
             cellptr->Redraw_Objects();
             return (true);
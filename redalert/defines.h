@@ -2800,6 +2800,37 @@ typedef enum BenchType : unsigned char
     BENCH_FIRST = 0
 } BenchType;
 
+/*
+**	Telemetry fields recorded each frame. The benchmarks above are timers using their
+**	BenchType as field number; these follow on after them.
+*/
+typedef enum TelemetryType : unsigned char
+{
+    TELEMETRY_UNITS = BENCH_COUNT, // Objects in each heap.
+    TELEMETRY_INFANTRY,
+    TELEMETRY_AIRCRAFT,
+    TELEMETRY_VESSELS,
+    TELEMETRY_BUILDINGS,
+    TELEMETRY_TERRAINS,
+    TELEMETRY_BULLETS,
+    TELEMETRY_ANIMS,
+    TELEMETRY_TEAMS,
+    TELEMETRY_TRIGGERS,
+    TELEMETRY_FACTORIES,
+
+    TELEMETRY_SPRINGS, // Trigger events evaluated.
+
+    TELEMETRY_QUEUE_AI,   // Network event queue processing.
+    TELEMETRY_OUT_EVENTS, // Events waiting to be sent.
+    TELEMETRY_DO_EVENTS,  // Events waiting to be executed.
+    TELEMETRY_MAX_AHEAD,  // Frames ahead that events are scheduled.
+    TELEMETRY_SEND_RATE,  // Frames between network packets.
+
+    TELEMETRY_SYNC_DELAY, // Time spent waiting for the next frame.
+
+    TELEMETRY_COUNT
+} TelemetryType;
+
 #if 0
 #define BStart(a)                                                                                                      \
     if (Benches != NULL)                                                                                               \
@@ -2808,8 +2839,8 @@ typedef enum BenchType : unsigned char
     if (Benches != NULL)                                                                                               \
     Benches[a].End()
 #else
-#define BStart(a)
-#define BEnd(a)
+#define BStart(a) Telemetry.Begin(a)
+#define BEnd(a)   Telemetry.End(a)
 #endif
 
 /**********************************************************************
@@ -36,6 +36,8 @@
  *   DisplayClass::Calculated_Cell -- Fetch a map cell based on specified method.              *
  *   DisplayClass::Cell_Object -- Determines what has been clicked on.                         *
  *   DisplayClass::Cell_Shadow   -- Determine what shadow icon to use for the cell.            *
+ *   DisplayClass::Update_Shadow_Index -- Records a change in a cell's mapped state.           *
+ *   DisplayClass::Rebuild_Shadow_Index -- Works out the shadow index of every cell from scratch.*
  *   DisplayClass::Center_Map -- Centers the map about the currently selected objects          *
  *   DisplayClass::Click_Cell_Calc -- Determines cell from screen X & Y.                       *
  *   DisplayClass::Closest_Free_Spot -- Finds the closest cell sub spot that is free.          *
@@ -122,6 +124,11 @@ unsigned char DisplayClass::ShadowTrans[(SHADOW_COL_COUNT + 1) * 256];
 */
 BooleanVectorClass DisplayClass::CellRedraw;
 
+/*
+** Mapped neighbour bits of every cell, per house
+*/
+unsigned char DisplayClass::ShadowIndex[HOUSE_COUNT][MAP_CELL_TOTAL];
+
 /*
 ** The main button that intercepts user input to the map
 */
@@ -285,6 +292,8 @@ void DisplayClass::Init_Clear(void)
     for (LayerType layer = LAYER_FIRST; layer < LAYER_COUNT; layer++) {
         Layer[layer].Init();
     }
+
+    Rebuild_Shadow_Index();
 }
 
 /***********************************************************************************************
@@ -1374,6 +1383,16 @@ int DisplayClass::Cell_Shadow(CELL cell, HouseClass* house) const
         value = -2;
 
     if (cellptr->Is_Mapped(house) /*&& !cellptr->IsVisible*/) {
+        /*
+        **	Away from the edge of the playfield every neighbour is in the radar
+        **	area, so the mapped neighbour bits kept in ShadowIndex give the table
+        **	index directly.
+        */
+        if ((unsigned)(Cell_X(cell) - 1 - MapCellX) < (unsigned)(MapCellWidth - 2)
+            && (unsigned)(Cell_Y(cell) - 1 - MapCellY) < (unsigned)(MapCellHeight - 2)) {
+            return (_shadow[~ShadowIndex[house->Class->House][cell] & 0xFF]);
+        }
+
         /*
         ** Build an index into the lookup table using all 8 surrounding cells.
         ** We're mapping a revealed cell and we only care about the existence
@@ -1418,6 +1437,73 @@ int DisplayClass::Cell_Shadow(CELL cell, HouseClass* house) const
     return (value);
 }
 
+/*
+**	Bit that a cell sets in the shadow index of its neighbour in each direction. The
+**	neighbour sees this cell from the opposite side, so FACING_N sets the south bit.
+*/
+static unsigned char const _ShadowBit[FACING_COUNT] = {0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04};
+
+/***********************************************************************************************
+ * DisplayClass::Update_Shadow_Index -- Records a change in a cell's mapped state.             *
+ *                                                                                             *
+ *    Sets or clears the bit for this cell in the shadow index of each of its eight            *
+ *    neighbours. Called whenever a house's mapped flag of a cell changes.                     *
+ *                                                                                             *
+ * INPUT:   cell     -- The cell that was mapped or shrouded.                                  *
+ *          house    -- The house whose view of the cell changed.                              *
+ *          mapped   -- Is the cell now mapped for this house?                                 *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void DisplayClass::Update_Shadow_Index(CELL cell, HousesType house, bool mapped)
+{
+    if ((unsigned)house >= HOUSE_COUNT || (unsigned)cell >= MAP_CELL_TOTAL) {
+        return;
+    }
+
+    unsigned char* index = ShadowIndex[house];
+    int x = Cell_X(cell);
+    for (FacingType dir = FACING_FIRST; dir < FACING_COUNT; dir++) {
+        CELL c = Adjacent_Cell(cell, dir);
+        if ((unsigned)c >= MAP_CELL_TOTAL || ABS(Cell_X(c) - x) > 1) {
+            continue;
+        }
+
+        if (mapped) {
+            index[c] |= _ShadowBit[dir];
+        } else {
+            index[c] &= ~_ShadowBit[dir];
+        }
+    }
+}
+
+/***********************************************************************************************
+ * DisplayClass::Rebuild_Shadow_Index -- Works out the shadow index of every cell from scratch.*
+ *                                                                                             *
+ *    Used when the cells have been cleared or loaded from a save game, since neither goes     *
+ *    through Set_Mapped.                                                                      *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void DisplayClass::Rebuild_Shadow_Index(void)
+{
+    memset(ShadowIndex, 0, sizeof(ShadowIndex));
+
+    for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
+        for (HousesType house = HOUSE_FIRST; house < HOUSE_COUNT; house++) {
+            if ((*this)[cell].Is_Mapped(house)) {
+                Update_Shadow_Index(cell, house, true);
+            }
+        }
+    }
+}
+
 #if (0) // Old code for reference. ST - 8/15/2019 10:25AM
 /***********************************************************************************************
  * DisplayClass::Cell_Shadow   -- Determine what shadow icon to use for the cell.              *
@@ -2769,7 +2855,7 @@ bool DisplayClass::Good_Reinforcement_Cell(CELL outcell, CELL incell, SpeedType
     **	If the map edge location is not clear for object placement, then this is not
     **	a good cell for reinforcement purposes.
     */
-    if (!(*this)[outcell].Is_Clear_To_Move(loco, false, false)) {
+    if (!CellClass::Is_Clear_To_Move(outcell, loco, false, false)) {
         return (false);
     }
 
@@ -2777,7 +2863,7 @@ bool DisplayClass::Good_Reinforcement_Cell(CELL outcell, CELL incell, SpeedType
     **	If it looks like the on-map cell cannot be driven on to, then return with
     **	the failure code.
     */
-    if (!(*this)[incell].Is_Clear_To_Move(loco, false, false, zone, mzone)) {
+    if (!CellClass::Is_Clear_To_Move(incell, loco, false, false, zone, mzone)) {
         return (false);
     }
 
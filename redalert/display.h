@@ -200,6 +200,8 @@ public:
     ObjectClass* Next_Object(ObjectClass* object) const;
     ObjectClass* Prev_Object(ObjectClass* object) const;
     int Cell_Shadow(CELL cell, HouseClass* house) const;
+    static void Update_Shadow_Index(CELL cell, HousesType house, bool mapped);
+    void Rebuild_Shadow_Index(void);
     short const* Text_Overlap_List(char const* text, int x, int y) const;
     bool Is_Spot_Free(COORDINATE coord) const;
     COORDINATE Closest_Free_Spot(COORDINATE coord, bool any = false) const;
@@ -339,6 +341,14 @@ private:
     */
     static BooleanVectorClass CellRedraw;
 
+    /*
+    **	For every house, this records which of the eight cells around each cell are
+    **	mapped, using the same bit layout Cell_Shadow uses to index its shadow table.
+    **	It is updated as cells are mapped and shrouded so that the shadow shape of a
+    **	cell doesn't have to be worked out from its neighbours on every redraw.
+    */
+    static unsigned char ShadowIndex[HOUSE_COUNT][MAP_CELL_TOTAL];
+
     bool Good_Reinforcement_Cell(CELL outcell, CELL incell, SpeedType loco, int zone, MZoneType mzone) const;
 
     //
@@ -1667,11 +1667,13 @@ void DriveClass::Mark_Track(COORDINATE headto, MarkType type)
                     if (TrackIndex < cellidx && cellidx != -1) {
                         COORDINATE offset = Smooth_Turn(ptr[cellidx].Offset, dir);
                         Map[offset].Flag.Occupy.Vehicle = value;
+                        Map[offset].Sync_Occupy();
                     }
                 }
             }
         }
         Map[headto].Flag.Occupy.Vehicle = value;
+        Map[headto].Sync_Occupy();
     }
 }
 
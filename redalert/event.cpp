@@ -479,6 +479,7 @@ void EventClass::Execute(void)
         techno = Data.NavCom.Whom.As_Techno();
         if (techno && techno->IsActive) {
             techno->ArchiveTarget = Data.NavCom.Where.As_TARGET();
+            Add_Referrer(techno->ArchiveTarget, techno->As_Target());
         }
         break;
 
@@ -728,6 +729,7 @@ void EventClass::Execute(void)
                 techno->Assign_Target(TARGET_NONE);
                 techno->Assign_Destination(Data.MegaMission.Target.As_TARGET());
                 techno->ArchiveTarget = Data.MegaMission.Target.As_TARGET();
+                Add_Referrer(techno->ArchiveTarget, techno->As_Target());
             } else if (Data.MegaMission.Mission == MISSION_ENTER && object != NULL
                        && object->What_Am_I() == RTTI_BUILDING && *((BuildingClass*)object) == STRUCT_REFINERY) {
                 techno->Transmit_Message(RADIO_HELLO, (BuildingClass*)object);
@@ -780,6 +782,7 @@ void EventClass::Execute(void)
                 && Data.MegaMission.Mission == MISSION_GUARD_AREA) {
 
                 ((FootClass*)techno)->ArchiveTarget = Data.MegaMission.Destination;
+                Add_Referrer(techno->ArchiveTarget, techno->As_Target());
             }
 #endif
         }
@@ -35,6 +35,8 @@
 #ifndef EXTERNS_H
 #define EXTERNS_H
 
+#include <atomic>
+
 #include "cell.h"
 
 #ifdef SCENARIO_EDITOR
@@ -309,7 +311,7 @@ extern VQAConfig AnimControl;
 extern long SpareTicks;
 extern long PathCount;
 extern long CellCount;
-extern long TargetScan;
+extern std::atomic<long> TargetScan; // counted from the think phase workers too
 extern long SidebarRedraws;
 extern DMonoType MonoPage;
 extern bool GameActive;
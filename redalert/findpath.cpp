@@ -49,6 +49,7 @@
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
+#include "common/framearena.h"
 //#include	<string.h>
 
 /*
@@ -141,9 +142,12 @@ inline static FacingType Next_Direction(FacingType facing, FacingType dir)
 /* Define a couple of variables which are private to the module they are   */
 /*      declared in.                                                       */
 /*=========================================================================*/
-static unsigned long MainOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the main path
-static unsigned long LeftOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the left path
-static unsigned long RightOverlap[MAP_CELL_TOTAL / 32]; // overlap list for the right path
+/*
+**	The overlap lists for the main, left and right paths are only needed during
+**	Find_Path, so they are taken from the calling thread's frame arena.
+*/
+#define OVERLAP_LONGS (MAP_CELL_TOTAL / 32)
+#define OVERLAP_SIZE  (OVERLAP_LONGS * sizeof(unsigned long))
 
 // static CELL MoveMask = 0;
 static CELL DestLocation;
@@ -458,6 +462,15 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
     if (!final_moves)
         return (NULL);
 
+    FrameArenaClass& arena = FrameArenaClass::Thread();
+    size_t mark = arena.Mark();
+    unsigned long* main_overlap = (unsigned long*)arena.Alloc(OVERLAP_SIZE * 3);
+    unsigned long* left_overlap = main_overlap + OVERLAP_LONGS;
+    unsigned long* right_overlap = left_overlap + OVERLAP_LONGS;
+
+    if (main_overlap == NULL)
+        return (NULL);
+
     BStart(BENCH_FINDPATH);
 
     PathCount++;
@@ -482,11 +495,11 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
     path.Length = 0;
     path.Command = final_moves;
     path.Command[0] = END;
-    path.Overlap = MainOverlap;
+    path.Overlap = main_overlap;
     path.LastOverlap = -1;
     path.LastFixup = -1;
 
-    memset(path.Overlap, 0, sizeof(MainOverlap));
+    memset(path.Overlap, 0, OVERLAP_SIZE);
 
     /*
     ** Clear the over lap list and then make sure that our starting position is marked
@@ -625,9 +638,9 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
 
                 Mem_Copy(&path, &pleft, sizeof(PathType));
                 pleft.Command = &moves_left[0];
-                pleft.Overlap = LeftOverlap;
+                pleft.Overlap = left_overlap;
                 Mem_Copy(path.Command, pleft.Command, path.Length);
-                Mem_Copy(path.Overlap, pleft.Overlap, sizeof(LeftOverlap));
+                Mem_Copy(path.Overlap, pleft.Overlap, OVERLAP_SIZE);
 
 // MBL 09.30.2019: We hit a runtime bounds crash where END (-1 / 0xFF) was being poked into +1 just past the end of the
 // moves_right[] array; The FacingType moves_left[] and moves_right[] arrays already have MAX_MLIST_SIZE+2 as their
@@ -646,9 +659,9 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
 
                 Mem_Copy(&path, &pright, sizeof(PathType));
                 pright.Command = &moves_right[0];
-                pright.Overlap = RightOverlap;
+                pright.Overlap = right_overlap;
                 Mem_Copy(path.Command, pright.Command, path.Length);
-                Mem_Copy(path.Overlap, pright.Overlap, sizeof(RightOverlap));
+                Mem_Copy(path.Overlap, pright.Overlap, OVERLAP_SIZE);
 
 // MBL 09.30.2019: We hit a runtime bounds crash where END (-1 / 0xFF) was being poked into +1 just past the end of the
 // moves_right[] array; The FacingType moves_left[] and moves_right[] arrays already have MAX_MLIST_SIZE+2 as their
@@ -737,7 +750,7 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
             len = which->Length;
             len = min(len, maxlen);
             if (len > 0) {
-                memcpy(&path.Overlap[0], &which->Overlap[0], sizeof(LeftOverlap));
+                memcpy(&path.Overlap[0], &which->Overlap[0], OVERLAP_SIZE);
                 memcpy(&path.Command[0], &which->Command[0], len * sizeof(FacingType));
                 path.Length = len;
                 path.Cost = which->Cost;
@@ -766,6 +779,12 @@ end_of_list:
     Optimize_Moves(&path, threshhold);
 #endif
 
+    /*
+    **	The overlap lists go back to the arena; callers only use the moves and cost.
+    */
+    path.Overlap = NULL;
+    arena.Rewind(mark);
+
     BEnd(BENCH_FINDPATH);
 
     return (&path);
@@ -1604,6 +1604,7 @@ void FootClass::Override_Mission(MissionType mission, TARGET tarcom, TARGET navc
     assert(IsActive);
 
     SuspendedNavCom = NavCom;
+    Add_Referrer(SuspendedNavCom, As_Target());
     TechnoClass::Override_Mission(mission, tarcom, navcom);
 
     Assign_Destination(navcom);
@@ -1833,6 +1834,7 @@ void FootClass::Assign_Destination(TARGET target)
     assert(IsActive);
 
     NavCom = target;
+    Add_Referrer(NavCom, As_Target());
 
     /*
     **	Presume that the easiest path is tried first. As the findpath proceeds, when
@@ -2357,6 +2359,7 @@ void FootClass::Handle_Navigation_List(void)
                 for (int index = 0; index < ARRAY_SIZE(NavQueue); index++) {
                     if (NavQueue[index] == TARGET_NONE) {
                         NavQueue[index] = target;
+                        Add_Referrer(target, As_Target());
                         break;
                     }
                 }
@@ -2407,6 +2410,7 @@ void FootClass::Queue_Navigation_List(TARGET target)
             }
             if (count < ARRAY_SIZE(NavQueue)) {
                 NavQueue[count] = target;
+                Add_Referrer(target, As_Target());
             }
         }
 
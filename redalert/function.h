@@ -51,6 +51,7 @@
 #define WWMEM_H
 
 #include "common/wwlib32.h"
+#include "common/telemetry.h"
 #include "bench.h"
 #include "compat.h"
 #include "fixed.h"
@@ -608,6 +609,9 @@ NeedType TeamMission_Needs(TeamMissionType tmtype);
 **	TRACKER.CPP
 */
 void Detach_This_From_All(TARGET target, bool all = true);
+void Add_Referrer(TARGET target, TARGET referrer);
+void Clear_Referrers(void);
+void Rebuild_Referrers(void);
 
 /*
 **	TRIGGER.CPP
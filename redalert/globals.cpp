@@ -365,7 +365,7 @@ Buffer* TheaterBuffer;
 long SpareTicks;
 long PathCount;      // Number of findpaths called.
 long CellCount;      // Number of cells redrawn.
-long TargetScan;     // Number of target scans.
+std::atomic<long> TargetScan; // Number of target scans.
 long SidebarRedraws; // Number of sidebar redraws.
 
 /***************************************************************************
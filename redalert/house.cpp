@@ -98,6 +98,12 @@
  *   HouseClass::Read_INI -- Reads house specific data from INI.                               *
  *   HouseClass::Recalc_Attributes -- Recalcs all houses existence bits.                       *
  *   HouseClass::Recalc_Center -- Recalculates the center point of the base.                   *
+ *   HouseClass::Scan_Add -- Starts counting an object in its owner's scan bits.               *
+ *   HouseClass::Scan_Changes -- Fetches a number that changes whenever ownership does.        *
+ *   HouseClass::Scan_Rebuild -- Counts every object in the game from scratch.                 *
+ *   HouseClass::Scan_Remove -- Stops counting an object in its owner's scan bits.             *
+ *   HouseClass::Scan_Reset -- Clears all scan counts.                                         *
+ *   HouseClass::Scan_Update -- Recounts an object whose owner or activity may have changed.   *
  *   HouseClass::Refund_Money -- Refunds money to back to the house.                           *
  *   HouseClass::Remap_Table -- Fetches the remap table for this house object.                 *
  *   HouseClass::Sell_Wall -- Tries to sell the wall at the specified location.                *
@@ -134,6 +140,7 @@
 #include "vortex.h"
 #include "rules.h"
 #include "utracker.h"
+#include "scanchange.h"
 
 //#include "WolDebug.h"
 
@@ -949,6 +956,8 @@ void HouseClass::Init(void)
     for (HousesType index = HOUSE_FIRST; index < HOUSE_COUNT; index++) {
         HouseTriggers[index].Clear();
     }
+
+    Scan_Reset();
 }
 
 // Object selection list is switched with player context for GlyphX. ST - 8/7/2019 10:11AM
@@ -3613,6 +3622,7 @@ bool HouseClass::Flag_Remove(TARGET target, bool set_home)
         if (set_home) {
             if (FlagHome != 0) {
                 Map[FlagHome].Overlay = OVERLAY_NONE;
+                Map[FlagHome].Sync_Overlay();
                 Map.Flag_Cell(FlagHome);
                 FlagHome = 0;
             }
@@ -3736,6 +3746,7 @@ bool HouseClass::Flag_Attach(CELL cell, bool set_home)
 
             if (set_home || FlagHome == 0) {
                 Map[newcell].Overlay = OVERLAY_FLAG_SPOT;
+                Map[newcell].Sync_Overlay();
                 Map[newcell].OverlayData = 0;
                 Map[newcell].Recalc_Attributes();
                 FlagHome = newcell;
@@ -4497,6 +4508,7 @@ void HouseClass::Sell_Wall(CELL cell)
 
                     Refund_Money(btype->Raw_Cost() * Rule.RefundPercent);
                     Map[cell].Overlay = OVERLAY_NONE;
+                    Map[cell].Sync_Overlay();
                     Map[cell].OverlayData = 0;
                     Map[cell].Owner = HOUSE_NONE;
                     Map[cell].Wall_Update();
@@ -6652,6 +6664,8 @@ void HouseClass::Tracking_Remove(TechnoClass const* techno)
 
     int type;
 
+    Scan_Remove(techno);
+
     switch (techno->What_Am_I()) {
     case RTTI_BUILDING:
         CurBuildings--;
@@ -6727,6 +6741,8 @@ void HouseClass::Tracking_Add(TechnoClass const* techno)
     VesselType vessel;
     int quant;
 
+    Scan_Add(techno);
+
     switch (techno->What_Am_I()) {
     case RTTI_BUILDING:
         CurBuildings++;
@@ -6993,12 +7009,355 @@ ZoneType HouseClass::Which_Zone(CELL cell) const
     return (Which_Zone(Cell_Coord(cell)));
 }
 
+/*
+**	The scan bits of every house are kept up to date by counting, for each house and object
+**	type, how many objects exist and how many of those are active. The kinds of object
+**	counted are indexed in this order.
+*/
+enum ScanKindEnum
+{
+    SCAN_UNIT,
+    SCAN_INFANTRY,
+    SCAN_AIRCRAFT,
+    SCAN_BUILDING,
+    SCAN_VESSEL,
+    SCAN_KIND_COUNT,
+
+    SCAN_TYPES = sizeof(unsigned long) * 8, // Types that fit in a scan bit field.
+    SCAN_ACTIVE = 0x80                      // Record flag: the object adds to the active bits.
+};
+
+/*
+**	What each object currently adds to the counts, indexed by kind and heap ID. Zero means
+**	the object isn't counted, otherwise it is the owning house plus one along with the
+**	SCAN_ACTIVE flag.
+*/
+static unsigned char* _ScanRecord[SCAN_KIND_COUNT];
+static int _ScanRecordSize[SCAN_KIND_COUNT];
+static int _ScanObjects;
+
+static unsigned short _ScanCount[HOUSE_COUNT][SCAN_KIND_COUNT][SCAN_TYPES];
+static unsigned short _ScanActiveCount[HOUSE_COUNT][SCAN_KIND_COUNT][SCAN_TYPES];
+static unsigned long _Scan[HOUSE_COUNT][SCAN_KIND_COUNT];
+static unsigned long _ScanActive[HOUSE_COUNT][SCAN_KIND_COUNT];
+
+/*
+**	The active bits depend on the owner being human and on the session type, so a change
+**	to either of those means counting everything again.
+*/
+static bool _ScanIsHuman[HOUSE_COUNT];
+static GameType _ScanSession;
+
+/*
+**	Moves on for a house and kind whenever one of its objects starts or stops being counted
+**	for it, including when the object changes hands, and for all of them when the counts
+**	are cleared.
+*/
+static ScanChangeClass<HOUSE_COUNT, SCAN_KIND_COUNT, SCAN_ACTIVE> _ScanChanges;
+
+static int _Scan_Kind(TechnoClass const* techno, int& type)
+{
+    switch (techno->What_Am_I()) {
+    case RTTI_UNIT:
+        type = ((UnitClass const*)techno)->Class->Type;
+        return (SCAN_UNIT);
+
+    case RTTI_INFANTRY:
+        type = ((InfantryClass const*)techno)->Class->Type;
+        return (SCAN_INFANTRY);
+
+    case RTTI_AIRCRAFT:
+        type = ((AircraftClass const*)techno)->Class->Type;
+        return (SCAN_AIRCRAFT);
+
+    case RTTI_BUILDING:
+        type = ((BuildingClass const*)techno)->Class->Type;
+        return (SCAN_BUILDING);
+
+    case RTTI_VESSEL:
+        type = ((VesselClass const*)techno)->Class->Type;
+        return (SCAN_VESSEL);
+
+    default:
+        break;
+    }
+    return (-1);
+}
+
+/*
+**	Works out what the object should add to the counts. This is the same test the old
+**	full sweep through all objects made every frame.
+*/
+static unsigned char _Scan_Value(TechnoClass const* techno)
+{
+    if (!techno->House) {
+        return (0);
+    }
+
+    unsigned char value = (unsigned char)(techno->House->Class->House + 1);
+    if (techno->IsLocked && !techno->IsInLimbo
+        && (Session.Type != GAME_NORMAL || !techno->House->IsHuman || techno->IsDiscoveredByPlayer)) {
+        value |= SCAN_ACTIVE;
+    }
+    return (value);
+}
+
+static void _Scan_Count(int kind, int type, unsigned char value, int delta)
+{
+    if (value == 0) {
+        return;
+    }
+
+    _ScanObjects += delta;
+
+    /*
+    **	Buildings past the first 32 types have never been given scan bits.
+    */
+    if (type < 0 || type >= SCAN_TYPES || (kind == SCAN_BUILDING && type >= 32)) {
+        return;
+    }
+
+    int house = (value & ~SCAN_ACTIVE) - 1;
+    unsigned long bit = 1UL << type;
+
+    _ScanCount[house][kind][type] += delta;
+    if (_ScanCount[house][kind][type] != 0) {
+        _Scan[house][kind] |= bit;
+    } else {
+        _Scan[house][kind] &= ~bit;
+    }
+
+    if (value & SCAN_ACTIVE) {
+        _ScanActiveCount[house][kind][type] += delta;
+        if (_ScanActiveCount[house][kind][type] != 0) {
+            _ScanActive[house][kind] |= bit;
+        } else {
+            _ScanActive[house][kind] &= ~bit;
+        }
+    }
+}
+
+/*
+**	Changes the counts of the object to the value given, growing the record table if
+**	needed. A value of zero stops the object being counted.
+*/
+static void _Scan_Set(TechnoClass const* techno, bool counted)
+{
+    int type = 0;
+    int kind = _Scan_Kind(techno, type);
+    int id = techno->ID;
+
+    if (kind < 0 || id < 0) {
+        return;
+    }
+
+    if (id >= _ScanRecordSize[kind]) {
+        if (!counted) {
+            return;
+        }
+
+        int size = _ScanRecordSize[kind] ? _ScanRecordSize[kind] : 64;
+        while (size <= id) {
+            size *= 2;
+        }
+
+        unsigned char* record = new unsigned char[size];
+        memset(record, 0, size);
+        if (_ScanRecord[kind] != NULL) {
+            memcpy(record, _ScanRecord[kind], _ScanRecordSize[kind]);
+            delete[] _ScanRecord[kind];
+        }
+        _ScanRecord[kind] = record;
+        _ScanRecordSize[kind] = size;
+    }
+
+    unsigned char& record = _ScanRecord[kind][id];
+    unsigned char old = record;
+    unsigned char value = counted ? _Scan_Value(techno) : 0;
+    if (_ScanChanges.Set(kind, record, value)) {
+        _Scan_Count(kind, type, old, -1);
+        _Scan_Count(kind, type, value, 1);
+    }
+}
+
+/***********************************************************************************************
+ * HouseClass::Scan_Add -- Starts counting an object in its owner's scan bits.                 *
+ *                                                                                             *
+ *    Called when an object joins a house's inventory, either by being created or captured.    *
+ *                                                                                             *
+ * INPUT:   techno   -- Pointer to the object to count.                                        *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void HouseClass::Scan_Add(TechnoClass const* techno)
+{
+    _Scan_Set(techno, true);
+}
+
+/***********************************************************************************************
+ * HouseClass::Scan_Remove -- Stops counting an object in its owner's scan bits.               *
+ *                                                                                             *
+ *    Called when an object leaves a house's inventory, either by being destroyed or captured. *
+ *                                                                                             *
+ * INPUT:   techno   -- Pointer to the object to stop counting.                                *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void HouseClass::Scan_Remove(TechnoClass const* techno)
+{
+    _Scan_Set(techno, false);
+}
+
+/***********************************************************************************************
+ * HouseClass::Scan_Update -- Recounts an object whose owner or activity may have changed.     *
+ *                                                                                             *
+ *    Called whenever something the scan bits depend on changes: the owner, entering or        *
+ *    leaving limbo, being locked onto the map or being discovered by the player. Objects that *
+ *    aren't being counted, such as one that is being destroyed, are left alone. A new owner   *
+ *    counts as a change to the objects of both the old and the new house.                     *
+ *                                                                                             *
+ * INPUT:   techno   -- Pointer to the object that changed.                                    *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void HouseClass::Scan_Update(TechnoClass const* techno)
+{
+    int type;
+    int kind = _Scan_Kind(techno, type);
+    int id = techno->ID;
+
+    if (kind >= 0 && id >= 0 && id < _ScanRecordSize[kind] && _ScanRecord[kind][id] != 0) {
+        _Scan_Set(techno, true);
+    }
+}
+
+/***********************************************************************************************
+ * HouseClass::Scan_Reset -- Clears all scan counts.                                           *
+ *                                                                                             *
+ *    Used when the object heaps are emptied for a new scenario.                               *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void HouseClass::Scan_Reset(void)
+{
+    for (int kind = 0; kind < SCAN_KIND_COUNT; kind++) {
+        if (_ScanRecord[kind] != NULL) {
+            memset(_ScanRecord[kind], 0, _ScanRecordSize[kind]);
+        }
+    }
+    memset(_ScanCount, 0, sizeof(_ScanCount));
+    memset(_ScanActiveCount, 0, sizeof(_ScanActiveCount));
+    memset(_Scan, 0, sizeof(_Scan));
+    memset(_ScanActive, 0, sizeof(_ScanActive));
+    _ScanObjects = 0;
+
+    _ScanChanges.Change_All();
+
+    for (HousesType house = HOUSE_FIRST; house < HOUSE_COUNT; house++) {
+        HouseClass const* hptr = HouseClass::As_Pointer(house);
+        _ScanIsHuman[house] = (hptr != NULL && hptr->IsHuman);
+    }
+    _ScanSession = Session.Type;
+}
+
+/***********************************************************************************************
+ * HouseClass::Scan_Changes -- Fetches a number that changes whenever ownership does.          *
+ *                                                                                             *
+ *    The number moves on whenever an object of the given kind joins or leaves the house's     *
+ *    inventory, and when the counts are cleared for a new scenario or a loaded game. Anything *
+ *    that caches which objects a house owns can compare it against the value it was built     *
+ *    with, and only sort out again the houses and kinds that have changed.                    *
+ *                                                                                             *
+ * INPUT:   house -- The house that owns the objects.                                          *
+ *                                                                                             *
+ *          rtti  -- The kind of object: unit, infantry, aircraft, building or vessel.         *
+ *                                                                                             *
+ * OUTPUT:  Returns with the current change number.                                            *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+unsigned long HouseClass::Scan_Changes(HousesType house, RTTIType rtti)
+{
+    int kind;
+
+    switch (rtti) {
+    case RTTI_UNIT:
+        kind = SCAN_UNIT;
+        break;
+
+    case RTTI_INFANTRY:
+        kind = SCAN_INFANTRY;
+        break;
+
+    case RTTI_AIRCRAFT:
+        kind = SCAN_AIRCRAFT;
+        break;
+
+    case RTTI_BUILDING:
+        kind = SCAN_BUILDING;
+        break;
+
+    case RTTI_VESSEL:
+        kind = SCAN_VESSEL;
+        break;
+
+    default:
+        return (0);
+    }
+
+    return (_ScanChanges.Get(house, kind));
+}
+
+/***********************************************************************************************
+ * HouseClass::Scan_Rebuild -- Counts every object in the game from scratch.                   *
+ *                                                                                             *
+ *    Used after loading a saved game, and whenever the counts can't be trusted any more.      *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void HouseClass::Scan_Rebuild(void)
+{
+    int index;
+
+    Scan_Reset();
+
+    for (index = 0; index < Units.Count(); index++) {
+        Scan_Add(Units.Ptr(index));
+    }
+    for (index = 0; index < Infantry.Count(); index++) {
+        Scan_Add(Infantry.Ptr(index));
+    }
+    for (index = 0; index < Aircraft.Count(); index++) {
+        Scan_Add(Aircraft.Ptr(index));
+    }
+    for (index = 0; index < Buildings.Count(); index++) {
+        Scan_Add(Buildings.Ptr(index));
+    }
+    for (index = 0; index < Vessels.Count(); index++) {
+        Scan_Add(Vessels.Ptr(index));
+    }
+}
+
 /***********************************************************************************************
  * HouseClass::Recalc_Attributes -- Recalcs all houses existence bits.                         *
  *                                                                                             *
- *    This routine will go through all game objects and reset the existence bits for the       *
- *    owning house. This method ensures that if the object exists, then the corresponding      *
- *    existence bit is also set.                                                               *
+ *    This routine will reset the existence bits of every house from the object counts kept   *
+ *    by the Scan_ functions. This method ensures that if the object exists, then the          *
+ *    corresponding existence bit is also set.                                                 *
  *                                                                                             *
  * INPUT:   none                                                                               *
  *                                                                                             *
@@ -7011,88 +7370,102 @@ ZoneType HouseClass::Which_Zone(CELL cell) const
  *=============================================================================================*/
 void HouseClass::Recalc_Attributes(void)
 {
+    int index;
+
     /*
-    **	Clear out all tracking values that will be filled in by this
-    **	routine. This allows the filling in process to not worry about
-    **	old existing values.
+    **	Count everything again if the inputs of the active test changed, or if the number of
+    **	objects counted has drifted from the number in the game.
     */
-    int index;
+    bool rebuild = (_ScanSession != Session.Type)
+                   || (_ScanObjects
+                       != Units.Count() + Infantry.Count() + Aircraft.Count() + Buildings.Count() + Vessels.Count());
+    for (index = 0; index < Houses.Count() && !rebuild; index++) {
+        HouseClass const* house = Houses.Ptr(index);
+        if (house != NULL && _ScanIsHuman[house->Class->House] != (bool)house->IsHuman) {
+            rebuild = true;
+        }
+    }
+    if (rebuild) {
+        Scan_Rebuild();
+    }
+
     for (index = 0; index < Houses.Count(); index++) {
         HouseClass* house = Houses.Ptr(index);
 
         if (house != NULL) {
-            house->BScan = 0;
-            house->ActiveBScan = 0;
-            house->IScan = 0;
-            house->ActiveIScan = 0;
-            house->UScan = 0;
-            house->ActiveUScan = 0;
-            house->AScan = 0;
-            house->ActiveAScan = 0;
-            house->VScan = 0;
-            house->ActiveVScan = 0;
-        }
-    }
-
+            HousesType h = house->Class->House;
+
+            house->BScan = _Scan[h][SCAN_BUILDING];
+            house->ActiveBScan = _ScanActive[h][SCAN_BUILDING];
+            house->OldBScan |= house->ActiveBScan;
+            house->IScan = _Scan[h][SCAN_INFANTRY];
+            house->ActiveIScan = _ScanActive[h][SCAN_INFANTRY];
+            house->OldIScan |= house->ActiveIScan;
+            house->UScan = _Scan[h][SCAN_UNIT];
+            house->ActiveUScan = _ScanActive[h][SCAN_UNIT];
+            house->AScan = _Scan[h][SCAN_AIRCRAFT];
+            house->ActiveAScan = _ScanActive[h][SCAN_AIRCRAFT];
+            house->OldAScan |= house->ActiveAScan;
+            house->VScan = _Scan[h][SCAN_VESSEL];
+            house->ActiveVScan = _ScanActive[h][SCAN_VESSEL];
+            house->OldVScan |= house->ActiveVScan;
+        }
+    }
+
+#ifndef NDEBUG
     /*
-    **	A second pass through the sentient objects is required so that the appropriate scan
-    **	bits will be set for the owner house.
+    **	Check the counts against a full sweep through all the objects, the way the bits
+    **	used to be worked out every frame.
     */
-    for (index = 0; index < Units.Count(); index++) {
-        UnitClass const* unit = Units.Ptr(index);
-        unit->House->UScan |= (1L << unit->Class->Type);
-        if (unit->IsLocked && (Session.Type != GAME_NORMAL || !unit->House->IsHuman || unit->IsDiscoveredByPlayer)) {
-            if (!unit->IsInLimbo) {
-                unit->House->ActiveUScan |= (1L << unit->Class->Type);
+    unsigned long scan[HOUSE_COUNT][SCAN_KIND_COUNT];
+    unsigned long active[HOUSE_COUNT][SCAN_KIND_COUNT];
+    memset(scan, 0, sizeof(scan));
+    memset(active, 0, sizeof(active));
+
+    for (int kind = 0; kind < SCAN_KIND_COUNT; kind++) {
+        for (index = 0;; index++) {
+            TechnoClass const* techno = NULL;
+            switch (kind) {
+            case SCAN_UNIT:
+                techno = index < Units.Count() ? Units.Ptr(index) : NULL;
+                break;
+            case SCAN_INFANTRY:
+                techno = index < Infantry.Count() ? Infantry.Ptr(index) : NULL;
+                break;
+            case SCAN_AIRCRAFT:
+                techno = index < Aircraft.Count() ? Aircraft.Ptr(index) : NULL;
+                break;
+            case SCAN_BUILDING:
+                techno = index < Buildings.Count() ? Buildings.Ptr(index) : NULL;
+                break;
+            case SCAN_VESSEL:
+                techno = index < Vessels.Count() ? Vessels.Ptr(index) : NULL;
+                break;
             }
-        }
-    }
-    for (index = 0; index < Infantry.Count(); index++) {
-        InfantryClass const* infantry = Infantry.Ptr(index);
-        infantry->House->IScan |= (1L << infantry->Class->Type);
-        if (infantry->IsLocked
-            && (Session.Type != GAME_NORMAL || !infantry->House->IsHuman || infantry->IsDiscoveredByPlayer)) {
-            if (!infantry->IsInLimbo) {
-                infantry->House->ActiveIScan |= (1L << infantry->Class->Type);
-                infantry->House->OldIScan |= (1L << infantry->Class->Type);
+            if (techno == NULL) {
+                break;
             }
-        }
-    }
-    for (index = 0; index < Aircraft.Count(); index++) {
-        AircraftClass const* aircraft = Aircraft.Ptr(index);
-        aircraft->House->AScan |= (1L << aircraft->Class->Type);
-        if (aircraft->IsLocked
-            && (Session.Type != GAME_NORMAL || !aircraft->House->IsHuman || aircraft->IsDiscoveredByPlayer)) {
-            if (!aircraft->IsInLimbo) {
-                aircraft->House->ActiveAScan |= (1L << aircraft->Class->Type);
-                aircraft->House->OldAScan |= (1L << aircraft->Class->Type);
+
+            int type;
+            _Scan_Kind(techno, type);
+            if (type >= SCAN_TYPES || (kind == SCAN_BUILDING && type >= 32)) {
+                continue;
             }
-        }
-    }
-    for (index = 0; index < Buildings.Count(); index++) {
-        BuildingClass const* building = Buildings.Ptr(index);
-        if (building->Class->Type < 32) {
-            building->House->BScan |= (1L << building->Class->Type);
-            if (building->IsLocked
-                && (Session.Type != GAME_NORMAL || !building->House->IsHuman || building->IsDiscoveredByPlayer)) {
-                if (!building->IsInLimbo) {
-                    building->House->ActiveBScan |= (1L << building->Class->Type);
-                    building->House->OldBScan |= (1L << building->Class->Type);
-                }
+
+            unsigned char value = _Scan_Value(techno);
+            if (value == 0) {
+                continue;
             }
-        }
-    }
-    for (index = 0; index < Vessels.Count(); index++) {
-        VesselClass const* vessel = Vessels.Ptr(index);
-        vessel->House->VScan |= (1L << vessel->Class->Type);
-        if (vessel->IsLocked
-            && (Session.Type != GAME_NORMAL || !vessel->House->IsHuman || vessel->IsDiscoveredByPlayer)) {
-            if (!vessel->IsInLimbo) {
-                vessel->House->ActiveVScan |= (1L << vessel->Class->Type);
-                vessel->House->OldVScan |= (1L << vessel->Class->Type);
+            int h = (value & ~SCAN_ACTIVE) - 1;
+            scan[h][kind] |= 1UL << type;
+            if (value & SCAN_ACTIVE) {
+                active[h][kind] |= 1UL << type;
             }
         }
     }
+    assert(memcmp(scan, _Scan, sizeof(scan)) == 0);
+    assert(memcmp(active, _ScanActive, sizeof(active)) == 0);
+#endif
 }
 
 /***********************************************************************************************
@@ -819,6 +819,12 @@ public:
     static void One_Time(void);
     static HouseClass* As_Pointer(HousesType house);
     static void Recalc_Attributes(void);
+    static void Scan_Add(TechnoClass const* techno);
+    static void Scan_Remove(TechnoClass const* techno);
+    static void Scan_Update(TechnoClass const* techno);
+    static void Scan_Reset(void);
+    static void Scan_Rebuild(void);
+    static unsigned long Scan_Changes(HousesType house, RTTIType rtti);
 
     /*
     ** New default win mode to avoid griefing. ST - 1/31/2020 3:33PM
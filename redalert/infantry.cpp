@@ -924,6 +924,7 @@ void InfantryClass::Per_Cell_Process(PCPType why)
                     building->Clicked_As_Target(building->Owner(), (Rule.C4Delay * TICKS_PER_MINUTE) / 2);
                     building->CountDown = Rule.C4Delay * TICKS_PER_MINUTE;
                     building->WhomToRepay = As_Target();
+                    Add_Referrer(building->WhomToRepay, building->As_Target());
                 }
                 NavCom = TARGET_NONE;
                 Do_Uncloak();
@@ -1170,6 +1171,7 @@ void InfantryClass::Assign_Destination(TARGET target)
                     // TCTCTC -- call for an update from the transport to get a good rendezvous position.
 
                     ArchiveTarget = target;
+                    Add_Referrer(ArchiveTarget, As_Target());
                 } else {
                     if (Transmit_Message(RADIO_HELLO, techno) == RADIO_ROGER) {
                         if (Transmit_Message(RADIO_DOCKING) != RADIO_ROGER) {
@@ -2425,6 +2427,7 @@ bool InfantryClass::Unlimbo(COORDINATE coord, DirType facing)
         */
         if (Class->SightRange == 0) {
             IsDiscoveredByPlayer = false;
+            HouseClass::Scan_Update(this);
         }
 
         Set_Occupy_Bit(coord);
@@ -3216,6 +3219,7 @@ void InfantryClass::Set_Occupy_Bit(CELL cell, int spot_index)
     ** Set the occupy position for the spot that we passed in
     */
     Map[cell].Flag.Composite |= (1 << spot_index);
+    Map[cell].Sync_Occupy();
 
     /*
     ** Record the type of infantry that now owns the cell
@@ -3244,6 +3248,7 @@ void InfantryClass::Clear_Occupy_Bit(CELL cell, int spot_index)
     ** Clear the occupy bit for the infantry in that cell
     */
     Map[cell].Flag.Composite &= ~(1 << spot_index);
+    Map[cell].Sync_Occupy();
 
     /*
     ** If he was the last infantry recorded in the cell then
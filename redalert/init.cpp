@@ -1540,6 +1540,14 @@ bool Parse_Command_Line(int argc, char* argv[])
             continue;
         }
 
+        /*
+        **	Scan for the objects' targets on the job system ahead of their AI.
+        */
+        if (strstr(string, "-THINK")) {
+            Special.IsParallelThink = true;
+            continue;
+        }
+
 #ifdef CHEAT_KEYS
         /*
         **	Specify the random number seed (for debugging)
@@ -290,7 +290,9 @@ bool MouseClass::Load(Straw& file)
         if (!(*this)[cell].Load(file)) {
             return (false);
         }
+        (*this)[cell].Sync_Hot();
     }
+    Rebuild_Shadow_Index();
 
     LastTheater = Scen.Theater;
     return (true);
@@ -33,15 +33,120 @@
  *   LogicClass::AI -- Handles AI logic processing for game objects.                           *
  *   LogicClass::Debug_Dump -- Displays logic class status to the mono screen.                 *
  *   LogicClass::Detach -- Detatch the specified target from the logic system.                 *
+ *   LogicClass::Greatest_Threat -- Fetches an object's threat scan, from the think phase.     *
+ *   LogicClass::Init_Telemetry -- Names the fields of the per frame telemetry record.         *
+ *   LogicClass::Record_Telemetry -- Records the state of the game for this frame.             *
+ *   LogicClass::Think -- Works out the objects' threat scans ahead of their AI.               *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
 #include "factory.h"
 #include "logic.h"
 #include "vortex.h"
+#include "common/settings.h"
+#include "common/jobs.h"
+#include "think.h"
 
 static unsigned FramesPerSecond = 0;
 
+/*
+**	What a threat scan of the think phase was worked out from. If any of it differs by
+**	the time the object asks for the scan, the scan is made again.
+*/
+typedef struct ThreatCheckStruct
+{
+    bool operator==(ThreatCheckStruct const& other) const
+    {
+        return (Coord == other.Coord && Threat == other.Threat && Mission == other.Mission && Owner == other.Owner
+                && IsScanLimited == other.IsScanLimited);
+    }
+
+    COORDINATE Coord;
+    ThreatType Threat;
+    MissionType Mission;
+    HousesType Owner;
+    bool IsScanLimited;
+} ThreatCheckType;
+
+static ThinkTableClass<RTTI_COUNT, ThreatCheckType, TARGET> _Thoughts;
+
+static ThreatCheckType Threat_Check(TechnoClass const* techno, ThreatType threat)
+{
+    ThreatCheckType check;
+
+    check.Coord = techno->Coord;
+    check.Threat = threat;
+    check.Mission = techno->Mission;
+    check.Owner = techno->Owner();
+    check.IsScanLimited = techno->Is_Foot() && ((FootClass const*)techno)->IsScanLimited;
+    return (check);
+}
+
+/*
+**	The objects, and the scans they're about to make, that the think phase works out
+**	for them. The results are filled in by the workers, each in its own place.
+*/
+typedef struct
+{
+    std::vector<TechnoClass const*> Objects;
+    std::vector<ThreatType> Threats;
+    std::vector<TARGET> Results;
+} ThinkType;
+
+static ThinkType _Think;
+
+/*
+**	Would the object's mission make a threat scan the think phase can work out, if it
+**	ran this frame? Only ground and sea objects with nothing to shoot at whose mission
+**	is due are looked at, and only the missions that scan with Target_Something_Nearby.
+**	A scan limited object is left alone, since its scan can change the object itself.
+*/
+static bool Thinks_About(ObjectClass const* object, ThreatType& threat)
+{
+    RTTIType rtti = object->What_Am_I();
+    if (rtti != RTTI_UNIT && rtti != RTTI_INFANTRY && rtti != RTTI_VESSEL) {
+        return (false);
+    }
+
+    FootClass const* foot = (FootClass const*)object;
+    if (foot->IsInLimbo || foot->Height > 0 || foot->Strength == 0 || !foot->Is_Mission_Due() || foot->IsScanLimited
+        || Target_Legal(foot->TarCom)) {
+        return (false);
+    }
+
+    switch (foot->Mission) {
+    case MISSION_MOVE:
+    case MISSION_QMOVE:
+        if (foot->House->IsHuman || foot->House->IsPlayerControl) {
+            return (false);
+        }
+        threat = THREAT_RANGE;
+        return (true);
+
+    case MISSION_GUARD:
+    case MISSION_STICKY:
+        threat = THREAT_RANGE;
+        return (true);
+
+    case MISSION_HUNT:
+        threat = THREAT_NORMAL;
+        return (true);
+
+    default:
+        break;
+    }
+    return (false);
+}
+
+static void Think_Range(void* data, int first, int last)
+{
+    ThinkType* think = (ThinkType*)data;
+
+    for (int index = first; index < last; index++) {
+        think->Results[index] = think->Objects[index]->Greatest_Threat(think->Threats[index]);
+    }
+}
+
 #ifdef CHEAT_KEYS
 /***********************************************************************************************
  * LogicClass::Debug_Dump -- Displays logic class status to the mono screen.                   *
@@ -152,7 +257,7 @@ void LogicClass::Debug_Dump(MonoClass* mono) const
     mono->Sub_Window(36, 1, 6, 11);
     mono->Scroll();
     mono->Set_Cursor(0, 10);
-    mono->Printf("%5d", TargetScan);
+    mono->Printf("%5d", TargetScan.load());
     TargetScan = 0;
 
     /*
@@ -190,6 +295,120 @@ void LogicClass::Debug_Dump(MonoClass* mono) const
 }
 #endif
 
+/***********************************************************************************************
+ * LogicClass::Init_Telemetry -- Names the fields of the per frame telemetry record.           *
+ *                                                                                             *
+ *    This defines every telemetry field the game reports, then opens the telemetry file if    *
+ *    one has been set in the configuration. The benchmark timers are reported along with      *
+ *    the object counts, trigger activity and network queue state.                             *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Call this once at startup, after the settings have been loaded.                 *
+ *=============================================================================================*/
+void LogicClass::Init_Telemetry(void)
+{
+    static struct
+    {
+        int Field;
+        char const* Name;
+        TelemetryClass::FieldKindType Kind;
+    } const _fields[] = {
+        {BENCH_GAME_FRAME, "game_frame", TelemetryClass::FIELD_TIMER},
+        {BENCH_FINDPATH, "findpath", TelemetryClass::FIELD_TIMER},
+        {BENCH_GREATEST_THREAT, "greatest_threat", TelemetryClass::FIELD_TIMER},
+        {BENCH_AI, "object_ai", TelemetryClass::FIELD_TIMER},
+        {BENCH_CELL, "cell_draw", TelemetryClass::FIELD_TIMER},
+        {BENCH_SIDEBAR, "sidebar", TelemetryClass::FIELD_TIMER},
+        {BENCH_RADAR, "radar", TelemetryClass::FIELD_TIMER},
+        {BENCH_TACTICAL, "tactical", TelemetryClass::FIELD_TIMER},
+        {BENCH_PCP, "per_cell_process", TelemetryClass::FIELD_TIMER},
+        {BENCH_EVAL_OBJECT, "eval_object", TelemetryClass::FIELD_TIMER},
+        {BENCH_EVAL_CELL, "eval_cell", TelemetryClass::FIELD_TIMER},
+        {BENCH_EVAL_WALL, "eval_wall", TelemetryClass::FIELD_TIMER},
+        {BENCH_POWER, "power", TelemetryClass::FIELD_TIMER},
+        {BENCH_TABS, "tabs", TelemetryClass::FIELD_TIMER},
+        {BENCH_SHROUD, "shroud", TelemetryClass::FIELD_TIMER},
+        {BENCH_ANIMS, "anim_draw", TelemetryClass::FIELD_TIMER},
+        {BENCH_OBJECTS, "object_draw", TelemetryClass::FIELD_TIMER},
+        {BENCH_PALETTE, "palette", TelemetryClass::FIELD_TIMER},
+        {BENCH_GSCREEN_RENDER, "render", TelemetryClass::FIELD_TIMER},
+        {BENCH_BLIT_DISPLAY, "blit", TelemetryClass::FIELD_TIMER},
+        {BENCH_MISSION, "mission", TelemetryClass::FIELD_TIMER},
+        {BENCH_RULES, "rules", TelemetryClass::FIELD_TIMER},
+        {BENCH_SCENARIO, "scenario", TelemetryClass::FIELD_TIMER},
+        {TELEMETRY_UNITS, "units", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_INFANTRY, "infantry", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_AIRCRAFT, "aircraft", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_VESSELS, "vessels", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_BUILDINGS, "buildings", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_TERRAINS, "terrains", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_BULLETS, "bullets", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_ANIMS, "anims", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_TEAMS, "teams", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_TRIGGERS, "triggers", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_FACTORIES, "factories", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_SPRINGS, "trigger_springs", TelemetryClass::FIELD_COUNT},
+        {TELEMETRY_QUEUE_AI, "queue_ai", TelemetryClass::FIELD_TIMER},
+        {TELEMETRY_OUT_EVENTS, "out_events", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_DO_EVENTS, "do_events", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_MAX_AHEAD, "max_ahead", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_SEND_RATE, "send_rate", TelemetryClass::FIELD_VALUE},
+        {TELEMETRY_SYNC_DELAY, "sync_delay", TelemetryClass::FIELD_TIMER},
+    };
+    static_assert(TELEMETRY_COUNT <= TelemetryClass::MAX_FIELDS, "Too many telemetry fields.");
+    static_assert(ARRAY_SIZE(_fields) == TELEMETRY_COUNT, "Every telemetry field needs a name.");
+
+    for (int index = 0; index < ARRAY_SIZE(_fields); index++) {
+        Telemetry.Define(_fields[index].Field, _fields[index].Name, _fields[index].Kind);
+    }
+
+    if (!Settings.Telemetry.File.empty()) {
+        Telemetry.Open(Settings.Telemetry.File.c_str());
+    }
+}
+
+/***********************************************************************************************
+ * LogicClass::Record_Telemetry -- Records the state of the game for this frame.               *
+ *                                                                                             *
+ *    This is the headless counterpart to Debug_Dump. It samples the object counts and the     *
+ *    network queues, then ends the telemetry frame so the timers and counts gathered during   *
+ *    it are stored.                                                                           *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Call this once at the end of every game frame.                                  *
+ *=============================================================================================*/
+void LogicClass::Record_Telemetry(void) const
+{
+    if (!Telemetry.Is_Enabled()) {
+        return;
+    }
+
+    Telemetry.Set(TELEMETRY_UNITS, Units.Count());
+    Telemetry.Set(TELEMETRY_INFANTRY, Infantry.Count());
+    Telemetry.Set(TELEMETRY_AIRCRAFT, Aircraft.Count());
+    Telemetry.Set(TELEMETRY_VESSELS, Vessels.Count());
+    Telemetry.Set(TELEMETRY_BUILDINGS, Buildings.Count());
+    Telemetry.Set(TELEMETRY_TERRAINS, Terrains.Count());
+    Telemetry.Set(TELEMETRY_BULLETS, Bullets.Count());
+    Telemetry.Set(TELEMETRY_ANIMS, Anims.Count());
+    Telemetry.Set(TELEMETRY_TEAMS, Teams.Count());
+    Telemetry.Set(TELEMETRY_TRIGGERS, Triggers.Count());
+    Telemetry.Set(TELEMETRY_FACTORIES, Factories.Count());
+
+    Telemetry.Set(TELEMETRY_OUT_EVENTS, OutList.Count);
+    Telemetry.Set(TELEMETRY_DO_EVENTS, DoList.Count);
+    Telemetry.Set(TELEMETRY_MAX_AHEAD, Session.MaxAhead);
+    Telemetry.Set(TELEMETRY_SEND_RATE, Session.FrameSendRate);
+
+    Telemetry.End_Frame(Frame);
+}
+
 /***********************************************************************************************
  * LogicClass::AI -- Handles AI logic processing for game objects.                             *
  *                                                                                             *
@@ -224,6 +443,13 @@ void LogicClass::AI(void)
     for (LogicTriggerID = 0; LogicTriggerID < LogicTriggers.Count(); LogicTriggerID++) {
         TriggerClass* trig = LogicTriggers[LogicTriggerID];
 
+        /*
+        **	None of the events sprung below are object or cell events, so if the trigger
+        **	is quiet for one of them it is quiet for all of them and can be skipped.
+        */
+        if (trig->Is_Quiet(TEVENT_TIME))
+            continue;
+
         /*
         **	Global changed trigger event might be triggered.
         */
@@ -343,6 +569,9 @@ void LogicClass::AI(void)
     /*
     **	AI for all sentient objects is processed.
     */
+    if (Special.IsParallelThink) {
+        Think();
+    }
     for (index = 0; index < Count(); index++) {
         ObjectClass* obj = (*this)[index];
         int count = Count();
@@ -445,6 +674,105 @@ void LogicClass::AI(void)
 #endif
 }
 
+/***********************************************************************************************
+ * LogicClass::Think -- Works out the objects' threat scans ahead of their AI.                 *
+ *                                                                                             *
+ *    When the think phase is on, the threat scans that the objects' missions are about to     *
+ *    make this frame are worked out on the job system before any object's AI runs, from the   *
+ *    state the frame starts in. Greatest_Threat hands them out as the objects ask. The scans  *
+ *    only read the game, so the results are the same however the work is split up.           *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   The telemetry timers can only be run from one thread, so the scans are all      *
+ *             made on this one while telemetry is being recorded.                             *
+ *=============================================================================================*/
+void LogicClass::Think(void)
+{
+    _Think.Objects.clear();
+    _Think.Threats.clear();
+
+    for (int index = 0; index < Count(); index++) {
+        ObjectClass const* obj = (*this)[index];
+        ThreatType threat;
+
+        if (Thinks_About(obj, threat)) {
+            _Think.Objects.push_back((TechnoClass const*)obj);
+            _Think.Threats.push_back(threat);
+        }
+    }
+
+    int count = (int)_Think.Objects.size();
+    _Think.Results.resize(count);
+    if (Telemetry.Is_Enabled()) {
+        Think_Range(&_Think, 0, count);
+    } else {
+        JobSystemClass::Shared().Parallel_For(0, count, THINK_GRAIN, Think_Range, &_Think);
+    }
+
+    for (int index = 0; index < count; index++) {
+        TechnoClass const* techno = _Think.Objects[index];
+        TARGET target = techno->As_Target();
+
+        /*
+        **	Debug builds make each scan again here, before anything has moved, to catch a
+        **	scan that doesn't just read the game.
+        */
+        assert(techno->Greatest_Threat(_Think.Threats[index]) == _Think.Results[index]);
+
+        _Thoughts.Put(Target_Kind(target),
+                      Target_Value(target),
+                      Frame,
+                      Threat_Check(techno, _Think.Threats[index]),
+                      _Think.Results[index]);
+    }
+}
+
+/***********************************************************************************************
+ * LogicClass::Greatest_Threat -- Fetches an object's threat scan, from the think phase.       *
+ *                                                                                             *
+ *    Hands out the scan the think phase made for the object this frame, if it made one with   *
+ *    the same inputs and what it found is still there. Otherwise the object makes the scan    *
+ *    itself, as it always does when the think phase is off.                                   *
+ *                                                                                             *
+ * INPUT:   techno   -- The object looking for something to shoot at.                          *
+ *                                                                                             *
+ *          threat   -- The kind of scan it wants to make.                                     *
+ *                                                                                             *
+ * OUTPUT:  Returns with the target found, or TARGET_NONE if there is none.                    *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+TARGET LogicClass::Greatest_Threat(TechnoClass const* techno, ThreatType threat)
+{
+    TARGET self = techno->As_Target();
+    TARGET target = TARGET_NONE;
+
+    if (Special.IsParallelThink
+        && _Thoughts.Take(Target_Kind(self), Target_Value(self), Frame, Threat_Check(techno, threat), target)) {
+        if (target == TARGET_NONE) {
+            return (target);
+        }
+
+        /*
+        **	Something that has died, been picked up or left the map since the frame began
+        **	is looked for again, as is a wall that is no longer worth shooting at.
+        */
+        ObjectClass const* object = As_Object(target);
+        if (object != NULL) {
+            if (!object->IsInLimbo && object->Strength > 0) {
+                return (target);
+            }
+        } else if (Is_Target_Cell(target) && techno->Evaluate_Just_Cell(As_Cell(target)) > 0) {
+            return (target);
+        }
+    }
+
+    return (techno->Greatest_Threat(threat));
+}
+
 /***********************************************************************************************
  * LogicClass::Detach -- Detatch the specified target from the logic system.                   *
  *                                                                                             *
@@ -44,11 +44,20 @@
 class LogicClass : public LayerClass
 {
 public:
+    enum
+    {
+        THINK_GRAIN = 16 // objects to each piece of work in the think phase
+    };
+
     void AI(void);
+    void Think(void);
+    TARGET Greatest_Threat(TechnoClass const* techno, ThreatType threat);
     void Detach(TARGET target, bool all = true);
 #ifdef CHEAT_KEYS
     void Debug_Dump(MonoClass* mono) const;
 #endif
+    static void Init_Telemetry(void);
+    void Record_Telemetry(void) const;
 
     /*
     ** Added. ST - 8/19/2019 5:46PM
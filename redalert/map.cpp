@@ -516,6 +516,7 @@ void MapClass::Init_Cells(void)
     TotalValue = 0;
     for (int index = 0; index < MAP_CELL_TOTAL; index++) {
         new (&Array[index]) CellClass;
+        Array[index].Sync_Hot();
     }
 }
 
@@ -572,11 +573,29 @@ void MapClass::Set_Map_Dimensions(int x, int y, int w, int h)
  *   03/08/1994 JLB : Updated to use sight table and incremental flag.                         *
  *   05/18/1994 JLB : Converted to member function.                                            *
  *=============================================================================================*/
+/*
+**	Sight stencils. For each sight range, these are the RadiusOffset entries that lie within
+**	that range, kept in the same order, together with the X offset of each so that the map
+**	edge wrap can be checked without converting cell numbers. Incremental scans only use the
+**	entries from the outer three rings, which start at RingStart.
+*/
+typedef struct
+{
+    int Offset;
+    int XOffset;
+} SightStencilType;
+
+static SightStencilType _SightStencil[11][309];
+static int _SightCount[11];
+static int _SightRingStart[11];
+static bool _SightStencilReady = false;
+
 void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool incremental)
 {
-    int xx;         // Center cell X coordinate (bounds checking).
-    int const* ptr; // Offset pointer.
-    int count;      // Counter for number of offsets to process.
+    int xx;                         // Center cell X coordinate (bounds checking).
+    SightStencilType const* ptr;    // Stencil pointer.
+    int count;                      // Counter for number of offsets to process.
+    HouseClass const* seen = house; // House whose map Map_Cell will actually update.
 
     /*
     **	Units that are off-map cannot sight.
@@ -586,6 +605,50 @@ void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool inc
     if (!sightrange || sightrange > 10)
         return;
 
+    /*
+    **	The first time through, work out which cells of each radius table lie within the
+    **	sight range. The distance between two cell centers only depends on their offset,
+    **	so it doesn't matter which cell they are worked out from.
+    */
+    if (!_SightStencilReady) {
+        CELL center = XY_Cell(MAP_CELL_W / 2, MAP_CELL_H / 2);
+
+        for (int range = 0; range < ARRAY_SIZE(RadiusCount); range++) {
+            int ring = (range > 2) ? RadiusCount[range - 3] : 0;
+
+            _SightCount[range] = 0;
+            for (int index = 0; index < RadiusCount[range]; index++) {
+                CELL newcell = center + RadiusOffset[index];
+
+                if (index == ring) {
+                    _SightRingStart[range] = _SightCount[range];
+                }
+                if (Distance(Cell_Coord(newcell), Cell_Coord(center)) > (range * CELL_LEPTON_W))
+                    continue;
+
+                SightStencilType& stencil = _SightStencil[range][_SightCount[range]++];
+                stencil.Offset = RadiusOffset[index];
+                stencil.XOffset = Cell_X(newcell) - Cell_X(center);
+            }
+        }
+        _SightStencilReady = true;
+    }
+
+    /*
+    **	Outside of GlyphX multiplayer, Map_Cell has nothing more to do for a cell that is
+    **	already mapped and visible to the house it maps for, once that house has been
+    **	redirected to the player for radar spying and alliances the same way Map_Cell does.
+    **	Such cells are skipped here rather than going through the whole call.
+    */
+    if (house == NULL || Session.Type == GAME_GLYPHX_MULTIPLAYER) {
+        seen = NULL;
+    } else if (house != PlayerPtr) {
+        if (house->RadarSpied & (1 << (PlayerPtr->Class->House)))
+            seen = PlayerPtr;
+        if (Session.Type == GAME_NORMAL && seen->Is_Ally(PlayerPtr))
+            seen = PlayerPtr;
+    }
+
     /*
     **	Determine logical cell coordinate for center scan point.
     */
@@ -595,23 +658,20 @@ void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool inc
     **	Incremental scans only scan the outer rings. Full scans
     **	scan all internal cells as well.
     */
-    count = RadiusCount[sightrange];
-    ptr = &RadiusOffset[0];
+    count = _SightCount[sightrange];
+    ptr = &_SightStencil[sightrange][0];
     if (incremental) {
-        if (sightrange > 2) {
-            ptr += RadiusCount[sightrange - 3];
-            count -= RadiusCount[sightrange - 3];
-        }
+        ptr += _SightRingStart[sightrange];
+        count -= _SightRingStart[sightrange];
     }
 
     /*
     **	Process all offsets required for the desired scan.
     */
     while (count--) {
-        CELL newcell; // New cell with offset.
-        int xdiff;    // New cell's X coordinate distance from center.
-
-        newcell = cell + *ptr++;
+        CELL newcell = cell + ptr->Offset; // New cell with offset.
+        int x = xx + ptr->XOffset;         // New cell's X coordinate.
+        ptr++;
 
         /*
         **	Determine if the map edge has been wrapped. If so,
@@ -619,13 +679,15 @@ void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool inc
         */
         if ((unsigned)newcell >= MAP_CELL_TOTAL)
             continue;
-        xdiff = Cell_X(newcell) - xx;
-        xdiff = ABS(xdiff);
-        if (xdiff > sightrange)
-            continue;
-        if (Distance(Cell_Coord(newcell), Cell_Coord(cell)) > (sightrange * CELL_LEPTON_W))
+        if ((unsigned)x >= MAP_CELL_W)
             continue;
 
+        if (seen != NULL) {
+            CellClass const* cellptr = &(*this)[newcell];
+            if (cellptr->Is_Mapped(seen->Class->House) && cellptr->Is_Visible(seen->Class->House))
+                continue;
+        }
+
         /*
         **	Map the cell. For incremental scans, then update
         **	adjacent cells as well. For full scans, just update
@@ -1542,6 +1604,7 @@ bool MapClass::Remove_Crate(CELL cell)
     CellClass* cellptr = &(*this)[cell];
     if (cellptr->Overlay != OVERLAY_NONE && OverlayTypeClass::As_Reference(cellptr->Overlay).IsCrate) {
         cellptr->Overlay = OVERLAY_NONE;
+        cellptr->Sync_Overlay();
         cellptr->OverlayData = 0;
         return (true);
     }
@@ -1802,16 +1865,16 @@ bool MapClass::Zone_Reset(int method)
     */
     for (int index = 0; index < MAP_CELL_TOTAL; index++) {
         if (method & MZONEF_NORMAL) {
-            Array[index].Zones[MZONE_NORMAL] = 0;
+            Array[index].Set_Zone(MZONE_NORMAL, 0);
         }
         if (method & MZONEF_CRUSHER) {
-            Array[index].Zones[MZONE_CRUSHER] = 0;
+            Array[index].Set_Zone(MZONE_CRUSHER, 0);
         }
         if (method & MZONEF_DESTROYER) {
-            Array[index].Zones[MZONE_DESTROYER] = 0;
+            Array[index].Set_Zone(MZONE_DESTROYER, 0);
         }
         if (method & MZONEF_WATER) {
-            Array[index].Zones[MZONE_WATER] = 0;
+            Array[index].Set_Zone(MZONE_WATER, 0);
         }
     }
 
@@ -1909,9 +1972,10 @@ int MapClass::Zone_Span(CELL cell, int zone, MZoneType check)
     **	until a boundary is reached.
     */
     for (; xbegin >= MapCellX; xbegin--) {
-        CellClass* cellptr = &(*this)[XY_Cell(xbegin, y)];
-        if (cellptr->Zones[check] != 0
-            || (!cellptr->Is_Clear_To_Move(check == MZONE_WATER ? SPEED_FLOAT : SPEED_TRACK, true, true, -1, check))) {
+        CELL spancell = XY_Cell(xbegin, y);
+        if (CellClass::HotZones[check][spancell] != 0
+            || (!CellClass::Is_Clear_To_Move(
+                spancell, check == MZONE_WATER ? SPEED_FLOAT : SPEED_TRACK, true, true, -1, check))) {
 
             /*
             **	Special short circuit code to bail from this entire routine if
@@ -1936,9 +2000,10 @@ int MapClass::Zone_Span(CELL cell, int zone, MZoneType check)
     **	extent of the current span.
     */
     for (; xend < MapCellX + MapCellWidth; xend++) {
-        CellClass* cellptr = &(*this)[XY_Cell(xend, y)];
-        if (cellptr->Zones[check] != 0
-            || (!cellptr->Is_Clear_To_Move(check == MZONE_WATER ? SPEED_FLOAT : SPEED_TRACK, true, true, -1, check))) {
+        CELL spancell = XY_Cell(xend, y);
+        if (CellClass::HotZones[check][spancell] != 0
+            || (!CellClass::Is_Clear_To_Move(
+                spancell, check == MZONE_WATER ? SPEED_FLOAT : SPEED_TRACK, true, true, -1, check))) {
             xend--;
             break;
         }
@@ -1950,7 +2015,7 @@ int MapClass::Zone_Span(CELL cell, int zone, MZoneType check)
     **	for the entire span.
     */
     for (int x = xbegin; x <= xend; x++) {
-        (*this)[XY_Cell(x, y)].Zones[check] = zone;
+        (*this)[XY_Cell(x, y)].Set_Zone(check, zone);
         filled++;
     }
 
@@ -2032,7 +2097,7 @@ CELL MapClass::Nearby_Location(CELL cell,
                 if (y >= top) {
                     newcell = XY_Cell(x, y);
                     cellptr = &Map[newcell];
-                    if (Map.In_Radar(newcell) && cellptr->Is_Clear_To_Move(speed, false, false, zone, check)
+                    if (Map.In_Radar(newcell) && CellClass::Is_Clear_To_Move(newcell, speed, false, false, zone, check)
                         && (!checkflagged || !cellptr->IsFlagged)) {
                         topten[count++] = newcell;
                     }
@@ -2044,7 +2109,7 @@ CELL MapClass::Nearby_Location(CELL cell,
                 if (y <= bottom) {
                     newcell = XY_Cell(x, y);
                     cellptr = &Map[newcell];
-                    if (Map.In_Radar(newcell) && cellptr->Is_Clear_To_Move(speed, false, false, zone, check)
+                    if (Map.In_Radar(newcell) && CellClass::Is_Clear_To_Move(newcell, speed, false, false, zone, check)
                         && (!checkflagged || !cellptr->IsFlagged)) {
                         topten[count++] = newcell;
                     }
@@ -2066,7 +2131,7 @@ CELL MapClass::Nearby_Location(CELL cell,
                 if (x >= left) {
                     newcell = XY_Cell(x, y);
                     cellptr = &Map[newcell];
-                    if (Map.In_Radar(newcell) && cellptr->Is_Clear_To_Move(speed, false, false, zone, check)
+                    if (Map.In_Radar(newcell) && CellClass::Is_Clear_To_Move(newcell, speed, false, false, zone, check)
                         && (!checkflagged || !cellptr->IsFlagged)) {
                         topten[count++] = newcell;
                     }
@@ -2078,7 +2143,7 @@ CELL MapClass::Nearby_Location(CELL cell,
                 if (x <= right) {
                     newcell = XY_Cell(x, y);
                     cellptr = &Map[newcell];
-                    if (Map.In_Radar(newcell) && cellptr->Is_Clear_To_Move(speed, false, false, zone, check)
+                    if (Map.In_Radar(newcell) && CellClass::Is_Clear_To_Move(newcell, speed, false, false, zone, check)
                         && (!checkflagged || !cellptr->IsFlagged)) {
                         topten[count++] = newcell;
                     }
@@ -890,6 +890,7 @@ int MapEditClass::Place_Object(void)
                     **	Clear smudge & overlay
                     */
                     (*this)[template_cell].Overlay = OVERLAY_NONE;
+                    (*this)[template_cell].Sync_Overlay();
                     (*this)[template_cell].OverlayData = 0;
                     (*this)[template_cell].Smudge = SMUDGE_NONE;
 
@@ -1511,6 +1512,7 @@ void MapEditClass::Toggle_House(void)
     */
     tp = (TechnoClass*)PendingObjectPtr;
     tp->House = HouseClass::As_Pointer(LastHouse);
+    HouseClass::Scan_Update(tp);
 
     /*
     **	Set house variables to new house
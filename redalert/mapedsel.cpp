@@ -582,6 +582,7 @@ bool MapEditClass::Change_House(HousesType newhouse)
     if (tp->House == PlayerPtr) {
         tp->IsOwnedByPlayer = true;
     }
+    HouseClass::Scan_Update(tp);
 
     return (true);
 }
@@ -82,6 +82,10 @@ public:
     {
         Timer = 0;
     }
+    bool Is_Mission_Due(void) const
+    {
+        return (Timer == 0);
+    }
     virtual MissionType Get_Mission(void) const;
     virtual void Assign_Mission(MissionType mission);
     virtual bool Commence(void);
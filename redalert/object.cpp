@@ -1443,6 +1443,9 @@ bool ObjectClass::Limbo(void)
         Hidden();
         IsInLimbo = true;
         IsToDisplay = false;
+        if (Is_Techno()) {
+            HouseClass::Scan_Update((TechnoClass const*)this);
+        }
         return (true);
     }
     return (false);
@@ -1476,6 +1479,9 @@ bool ObjectClass::Unlimbo(COORDINATE coord, DirType)
             IsInLimbo = false;
             IsToDisplay = false;
             Coord = Class_Of().Coord_Fixup(coord);
+            if (Is_Techno()) {
+                HouseClass::Scan_Update((TechnoClass const*)this);
+            }
 
             if (Mark(MARK_DOWN)) {
                 if (IsActive) {
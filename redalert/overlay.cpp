@@ -173,6 +173,7 @@ bool OverlayClass::Mark(MarkType mark)
             if (Class->IsWall) {
                 if (cellptr->Is_Clear_To_Build()) {
                     cellptr->Overlay = Class->Type;
+                    cellptr->Sync_Overlay();
                     cellptr->OverlayData = 0;
                     cellptr->Redraw_Objects();
                     cellptr->Wall_Update();
@@ -210,6 +211,7 @@ bool OverlayClass::Mark(MarkType mark)
                 if ((ScenarioInit || cellptr->Overlay == OVERLAY_NONE) && clear) {
 
                     cellptr->Overlay = Class->Type;
+                    cellptr->Sync_Overlay();
                     cellptr->OverlayData = 0;
 
                     cellptr->Redraw_Objects();
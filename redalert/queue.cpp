@@ -76,6 +76,7 @@
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 #include "function.h"
 #include "msgbox.h"
+#include "whomdelta.h"
 
 #ifdef WOLAPI_INTEGRATION
 //#include "WolDebug.h"
@@ -714,7 +715,7 @@ static void Queue_AI_Multiplayer(void)
         //.....................................................................
         // Initialize the frame timers
         //.....................................................................
-        if (Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+        if (Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
             Process_Send_Period(net); //, 1);
         }
 
@@ -738,7 +739,7 @@ static void Queue_AI_Multiplayer(void)
         // If we're the net "master", compute our desired frame rate & new
         // 'MaxAhead' value.
         //
-        if (Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+        if (Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
 
             //
             // All systems will transmit their required process time.
@@ -762,7 +763,7 @@ static void Queue_AI_Multiplayer(void)
     //------------------------------------------------------------------------
     // Only process every 'FrameSendRate' frames
     //------------------------------------------------------------------------
-    if (Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+    if (Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
         if (!Process_Send_Period(net)) { //, 0)) {
             if (IsMono) {
                 MonoClass::Disable();
@@ -1307,7 +1308,7 @@ static void Generate_Timing_Event(ConnManClass* net, int my_sent)
             // For multi-frame compressed events, the MaxAhead must be an even
             // multiple of the FrameSendRate.
             //..................................................................
-            if (Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+            if (Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
                 ev.Data.FrameInfo.Delay = max(
                     ((((resp_time / 8) + (Session.FrameSendRate - 1)) / Session.FrameSendRate) * Session.FrameSendRate),
                     (Session.FrameSendRate * 2));
@@ -1702,7 +1703,7 @@ static void Send_FrameSync(ConnManClass* net, int cmd_count)
     // games compare scenario CRC's on startup.
     //------------------------------------------------------------------------
     packet.Type = EventClass::FRAMESYNC;
-    if (Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+    if (Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
         packet.Frame =
             ((Frame + Session.MaxAhead + (Session.FrameSendRate - 1)) / Session.FrameSendRate) * Session.FrameSendRate;
     } else {
@@ -2335,7 +2336,7 @@ static int Build_Send_Packet(void* buf, int bufsize, int frame_delay, int num_cm
     //........................................................................
     // Set the frame to execute this event on; this is protocol-specific
     //........................................................................
-    if (Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+    if (Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
         finfo->Frame =
             ((Frame + frame_delay + (Session.FrameSendRate - 1)) / Session.FrameSendRate) * Session.FrameSendRate;
     } else {
@@ -2381,6 +2382,7 @@ static int Build_Send_Packet(void* buf, int bufsize, int frame_delay, int num_cm
     //.....................................................................
     case (COMM_PROTOCOL_SINGLE_E_COMP):
     case (COMM_PROTOCOL_MULTI_E_COMP):
+    case (COMM_PROTOCOL_MULTI_DELTA_COMP):
         size = Add_Compressed_Events(buf, bufsize, frame_delay, size, cap);
         break;
 
@@ -2515,11 +2517,19 @@ static int Add_Compressed_Events(void* buf, int bufsize, int frame_delay, int si
     unsigned char* unitsptr = NULL;  // ptr to buffer pos to store mega. rep count
     unsigned char numunits = 0;      // megamission rep count value
     bool missiondup = false;         // flag: is this event a megamission repeat?
+    bool deltawhom;                  // flag: are the 'Whom's in a run delta-coded?
+    unsigned char runflag;           // flag stored along with the rep count
 
     if (Debug_Print_Events) {
         printf("\n(%d) Building Send Packet\n", Frame);
     }
 
+    //------------------------------------------------------------------------
+    // Older protocols store every 'Whom' in a run verbatim.
+    //------------------------------------------------------------------------
+    deltawhom = (Session.CommProtocol >= COMM_PROTOCOL_MULTI_DELTA_COMP);
+    runflag = deltawhom ? MEGAMISSION_DELTA : 0;
+
     //------------------------------------------------------------------------
     // Loop until there are no more events, we've processed our max # of
     // events, or the buffer is full.
@@ -2559,16 +2569,17 @@ static int Add_Compressed_Events(void* buf, int bufsize, int frame_delay, int si
             //..................................................................
             if (eventtype == EventClass::MEGAMISSION) {
                 //...............................................................
-                // If the Mission, Target, & Destination are the same, compress
-                // the events into one:
-                // - Change datasize to the size of the 'Whom' field only
+                // If the Mission, Target, & Destination are the same, and the
+                // run isn't full, compress the events into one:
+                // - Change datasize to the size of the encoded 'Whom'
                 // - set total # bytes to store to the size of the 'Whom' only
                 // - increment the MegaMission rep count
                 // - set the MegaMission rep flag
                 //...............................................................
                 if (OutList.First().Data.MegaMission.Mission == prevevent.Data.MegaMission.Mission
                     && OutList.First().Data.MegaMission.Target == prevevent.Data.MegaMission.Target
-                    && OutList.First().Data.MegaMission.Destination == prevevent.Data.MegaMission.Destination) {
+                    && OutList.First().Data.MegaMission.Destination == prevevent.Data.MegaMission.Destination
+                    && numunits < MEGAMISSION_RUN_MAX) {
 #if (0) // PG
                     if (Debug_Print_Events) {
                         printf("      adding Whom:%x (%x) Mission:%s Target:%x (%x) Dest:%x (%x)\n",
@@ -2581,7 +2592,10 @@ static int Add_Compressed_Events(void* buf, int bufsize, int frame_delay, int si
                                OutList.First().Data.MegaMission.Destination);
                     }
 #endif
-                    datasize = sizeof(prevevent.Data.MegaMission.Whom);
+                    datasize = Encode_Whom(NULL,
+                                           prevevent.Data.MegaMission.Whom.As_TARGET(),
+                                           OutList.First().Data.MegaMission.Whom.As_TARGET(),
+                                           deltawhom);
                     storedsize = datasize;
                     numunits++;
                     missiondup = true;
@@ -2601,7 +2615,7 @@ static int Add_Compressed_Events(void* buf, int bufsize, int frame_delay, int si
                         printf("  New MEGAMISSION run:\n");
                     }
 
-                    *unitsptr = numunits;
+                    *unitsptr = numunits | runflag;
                     unitsptr = ((unsigned char*)buf) + size + sizeof(EventClass::EventType);
                     storedsize += sizeof(numunits);
                     numunits = 1;
@@ -2615,7 +2629,7 @@ static int Add_Compressed_Events(void* buf, int bufsize, int frame_delay, int si
             // - Clear variables
             //..................................................................
             else {
-                *unitsptr = numunits; // save # events in our run
+                *unitsptr = numunits | runflag; // save # events in our run
                 unitsptr = NULL;      // init other values
                 numunits = 0;
                 missiondup = false;
@@ -2653,7 +2667,7 @@ static int Add_Compressed_Events(void* buf, int bufsize, int frame_delay, int si
         //.....................................................................
         // Set the event's frame delay (this is protocol-dependent)
         //.....................................................................
-        if (Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+        if (Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
             OutList.First().Frame =
                 ((Frame + frame_delay + (Session.FrameSendRate - 1)) / Session.FrameSendRate) * Session.FrameSendRate;
         } else {
@@ -2701,14 +2715,16 @@ static int Add_Compressed_Events(void* buf, int bufsize, int frame_delay, int si
             //...............................................................
             // Repeated mission in a run:
             //   - Update the rep count (in case we break out)
-            //   - Copy the Whom field only
+            //   - Store the Whom field, as a delta from the previous unit if
+            //     the protocol allows
             //...............................................................
             if (missiondup) {
-                *unitsptr = numunits;
+                *unitsptr = numunits | runflag;
 
-                memcpy(((char*)buf) + size, &OutList.First().Data.MegaMission.Whom, datasize);
-
-                size += datasize;
+                size += Encode_Whom(((unsigned char*)buf) + size,
+                                    prevevent.Data.MegaMission.Whom.As_TARGET(),
+                                    OutList.First().Data.MegaMission.Whom.As_TARGET(),
+                                    deltawhom);
             }
             //...............................................................
             // 1st mission in a run:
@@ -2717,7 +2733,7 @@ static int Add_Compressed_Events(void* buf, int bufsize, int frame_delay, int si
             //   - Copy the MegaMission structure, leaving room for 'numunits'
             //...............................................................
             else {
-                *unitsptr = numunits;
+                *unitsptr = numunits | runflag;
 
                 *(EventClass::EventType*)(((char*)buf) + size) = eventtype;
 
@@ -2921,6 +2937,9 @@ static int Extract_Compressed_Events(void* buf, int bufsize)
     int datasize = 0;           // size of data to copy
     EventClass eventdata{};     // stores Frame, ID, etc
     unsigned char numunits = 0; // # units stored in compressed MegaMissions
+    bool deltawhom = false;     // are the MegaMission 'Whom's delta-coded?
+    TARGET whom;                // decoded MegaMission 'Whom'
+    int whomsize;               // # bytes used by an encoded 'Whom'
 
     //------------------------------------------------------------------------
     // Assume the first event is a FRAMEINFO event
@@ -2959,6 +2978,10 @@ static int Extract_Compressed_Events(void* buf, int bufsize)
             //..................................................................
             else if (event->Type == EventClass::MEGAMISSION) {
                 numunits = *(((unsigned char*)buf) + pos + sizeof(eventdata.Type));
+                deltawhom = Session.CommProtocol >= COMM_PROTOCOL_MULTI_DELTA_COMP && (numunits & MEGAMISSION_DELTA) != 0;
+                if (deltawhom) {
+                    numunits &= MEGAMISSION_RUN_MAX;
+                }
                 pos += sizeof(numunits);
                 leftover -= sizeof(numunits);
             }
@@ -2992,7 +3015,47 @@ static int Extract_Compressed_Events(void* buf, int bufsize)
             case (EventClass::MEGAMISSION):
                 memcpy(&eventdata.Data.MegaMission, ((char*)buf) + pos + sizeof(EventClass::EventType), datasize);
 
-                if (numunits > 1) {
+                if (numunits > 1 && deltawhom) {
+                    pos += (datasize + sizeof(EventClass::EventType));
+                    leftover -= (datasize + sizeof(EventClass::EventType));
+
+                    while (numunits) {
+
+                        Keyboard->Check();
+
+                        if (!DoList.Add(eventdata)) {
+                            return (-1);
+                        }
+#ifdef MIRROR_QUEUE
+                        MirrorList.Add(eventdata);
+#endif
+
+                        //......................................................
+                        // Keep count of how many events we add to the queue
+                        //......................................................
+                        count++;
+                        numunits--;
+                        whomsize = Decode_Whom_Delta(((unsigned char*)buf) + pos,
+                                                     leftover,
+                                                     eventdata.Data.MegaMission.Whom.As_TARGET(),
+                                                     whom);
+                        if (whomsize == 0) {
+                            return (count);
+                        }
+                        memcpy(&eventdata.Data.MegaMission.Whom, &whom, sizeof(whom));
+
+                        //......................................................
+                        // if one unit left fall thru to normal code
+                        //......................................................
+                        if (numunits == 1) {
+                            datasize = whomsize - sizeof(EventClass::EventType);
+                            break;
+                        } else {
+                            pos += whomsize;
+                            leftover -= whomsize;
+                        }
+                    }
+                } else if (numunits > 1) {
                     pos += (datasize + sizeof(EventClass::EventType));
                     leftover -= (datasize + sizeof(EventClass::EventType));
                     datasize = sizeof(eventdata.Data.MegaMission.Whom);
@@ -3517,7 +3580,7 @@ static void Queue_Playback(void)
     //------------------------------------------------------------------------
     testframe = ((Frame + (Session.FrameSendRate - 1)) / Session.FrameSendRate) * Session.FrameSendRate;
     if ((Session.Type != GAME_NORMAL && Session.Type != GAME_SKIRMISH)
-        && Session.CommProtocol == COMM_PROTOCOL_MULTI_E_COMP) {
+        && Session.CommProtocol >= COMM_PROTOCOL_MULTI_E_COMP) {
         if (Frame != testframe) {
             return;
         }
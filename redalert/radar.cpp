@@ -80,6 +80,87 @@ static bool FullRedraw = false;
 static GraphicBufferClass _IconStage(3, 3);
 static GraphicBufferClass _TileStage(24, 24);
 
+/*
+**	When the radar is zoomed, each cell shows its terrain template icon scaled down
+**	to ZoomFactor pixels square. Scaling a template icon through the staging buffer
+**	is the most expensive part of plotting a radar pixel, yet the terrain rarely
+**	changes while units move over it. The scaled template image is therefore kept
+**	in a persistent base buffer that mirrors the radar display area. Each cell
+**	remembers which template icon its slot in the base buffer holds; the slot is
+**	only rebuilt when that changes or when the radar layout is altered.
+*/
+#define RADAR_BASE_WIDTH  160
+#define RADAR_BASE_HEIGHT 160
+
+static GraphicBufferClass _RadarBase(RADAR_BASE_WIDTH, RADAR_BASE_HEIGHT);
+static unsigned int _RadarBaseKey[MAP_CELL_TOTAL];
+static struct
+{
+    int RadarX;
+    int RadarY;
+    int BaseX;
+    int BaseY;
+    int Zoom;
+    int Theater;
+} _RadarBaseLayout = {-1, -1, -1, -1, -1, -1};
+
+static void Radar_Base_Invalidate(void)
+{
+    _RadarBaseLayout.Zoom = -1;
+}
+
+static void Radar_Base_Sync(int radarx, int radary, int basex, int basey, int zoom)
+{
+    if (_RadarBaseLayout.RadarX != radarx || _RadarBaseLayout.RadarY != radary || _RadarBaseLayout.BaseX != basex
+        || _RadarBaseLayout.BaseY != basey || _RadarBaseLayout.Zoom != zoom
+        || _RadarBaseLayout.Theater != Scen.Theater) {
+        memset(_RadarBaseKey, 0, sizeof(_RadarBaseKey));
+        _RadarBaseLayout.RadarX = radarx;
+        _RadarBaseLayout.RadarY = radary;
+        _RadarBaseLayout.BaseX = basex;
+        _RadarBaseLayout.BaseY = basey;
+        _RadarBaseLayout.Zoom = zoom;
+        _RadarBaseLayout.Theater = Scen.Theater;
+    }
+}
+
+/*
+**	Copies a cached template slot to the destination, skipping transparent pixels
+**	exactly as the transparent scale into the logic page would have done.
+*/
+static void Radar_Base_Copy(GraphicViewPortClass& dest, int bx, int by, int x, int y, int size)
+{
+    int w = size;
+    int h = size;
+    if (x < 0 || y < 0) {
+        return;
+    }
+    if (x + w > dest.Get_Width()) {
+        w = dest.Get_Width() - x;
+    }
+    if (y + h > dest.Get_Height()) {
+        h = dest.Get_Height() - y;
+    }
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    int spitch = _RadarBase.Get_Width() + _RadarBase.Get_XAdd() + _RadarBase.Get_Pitch();
+    int dpitch = dest.Get_Width() + dest.Get_XAdd() + dest.Get_Pitch();
+    unsigned char const* src = (unsigned char const*)_RadarBase.Get_Offset() + by * spitch + bx;
+    unsigned char* dst = (unsigned char*)dest.Get_Offset() + y * dpitch + x;
+
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            if (src[col] != 0) {
+                dst[col] = src[col];
+            }
+        }
+        src += spitch;
+        dst += dpitch;
+    }
+}
+
 /***********************************************************************************************
  * RadarClass::RadarClass -- Default constructor for RadarClass object.                        *
  *                                                                                             *
@@ -195,6 +276,7 @@ void RadarClass::Init_Clear(void)
     DoesRadarExist = false;
     PixelPtr = 0;
     IsPlayerNames = false;
+    Radar_Base_Invalidate();
 
     /*
     ** If we have a valid map lets make sure that we set it correctly
@@ -1020,6 +1102,7 @@ void RadarClass::Plot_Radar_Pixel(CELL cell)
             if (ZoomFactor > 1) {
                 void const* ptr = NULL;
                 int icon;
+                int ttype = TEMPLATE_CLEAR1;
 
                 /*
                 **	Fetch the template pointer and template icon number for the
@@ -1028,6 +1111,7 @@ void RadarClass::Plot_Radar_Pixel(CELL cell)
                 if (cellptr->TType != TEMPLATE_NONE && cellptr->TType != 255) {
                     ptr = TemplateTypeClass::As_Reference(cellptr->TType).Get_Image_Data();
                     icon = cellptr->TIcon;
+                    ttype = cellptr->TType;
                 }
 
                 /*
@@ -1037,6 +1121,7 @@ void RadarClass::Plot_Radar_Pixel(CELL cell)
                 if (ptr == NULL) {
                     ptr = TemplateTypeClass::As_Reference(TEMPLATE_CLEAR1).Get_Image_Data();
                     icon = cellptr->Clear_Icon();
+                    ttype = TEMPLATE_CLEAR1;
                 }
 
                 IconsetClass const* iconset = (IconsetClass const*)ptr;
@@ -1049,8 +1134,28 @@ void RadarClass::Plot_Radar_Pixel(CELL cell)
                 icon = *(iconset->Map_Data() + icon);
 
                 unsigned char* data = (unsigned char*)icondata + icon * (24 * 24);
-                Buffer_To_Page(0, 0, 24, 24, data, _TileStage);
-                _TileStage.Scale(*LogicPage, 0, 0, x, y, 24, 24, ZoomFactor, ZoomFactor, true);
+
+                /*
+                **	Fetch the scaled icon from the radar base buffer, rebuilding the
+                **	cell's slot only if it holds a different icon.
+                */
+                int bx = x - (RadX + RadOffX);
+                int by = y - (RadY + RadOffY);
+                if (bx >= 0 && by >= 0 && bx + ZoomFactor <= RADAR_BASE_WIDTH
+                    && by + ZoomFactor <= RADAR_BASE_HEIGHT) {
+                    Radar_Base_Sync(RadarX, RadarY, BaseX, BaseY, ZoomFactor);
+                    unsigned int key = ((unsigned int)ttype << 16) + (unsigned int)icon + 1;
+                    if (_RadarBaseKey[cell] != key) {
+                        _RadarBase.Fill_Rect(bx, by, bx + ZoomFactor - 1, by + ZoomFactor - 1, 0);
+                        Buffer_To_Page(0, 0, 24, 24, data, _TileStage);
+                        _TileStage.Scale(_RadarBase, 0, 0, bx, by, 24, 24, ZoomFactor, ZoomFactor, true);
+                        _RadarBaseKey[cell] = key;
+                    }
+                    Radar_Base_Copy(*LogicPage, bx, by, x, y, ZoomFactor);
+                } else {
+                    Buffer_To_Page(0, 0, 24, 24, data, _TileStage);
+                    _TileStage.Scale(*LogicPage, 0, 0, x, y, 24, 24, ZoomFactor, ZoomFactor, true);
+                }
             } else {
                 //				LogicPage->Fill_Rect(x, y, x+ZoomFactor-1, y+ZoomFactor-1, cellptr->Cell_Color(false));
                 /*BG*/ LogicPage->Put_Pixel(x, y, cellptr->Cell_Color(false));
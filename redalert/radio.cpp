@@ -168,6 +168,7 @@ RadioMessageType RadioClass::Receive_Message(RadioClass* from, RadioMessageType
     if (message == RADIO_HELLO && Strength) {
         if (Radio == from || Radio == NULL) {
             Radio = from;
+            Add_Referrer(from->As_Target(), As_Target());
             return (RADIO_ROGER);
         }
         return (RADIO_NEGATIVE);
@@ -228,6 +229,7 @@ RadioMessageType RadioClass::Transmit_Message(RadioMessageType message, long& pa
         Transmit_Message(RADIO_OVER_OUT);
         if (to->Receive_Message(this, message, param) == RADIO_ROGER) {
             Radio = to;
+            Add_Referrer(to->As_Target(), As_Target());
             return (RADIO_ROGER);
         }
         return (RADIO_NEGATIVE);
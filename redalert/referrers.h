@@ -0,0 +1,120 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef REFERRERS_H
+#define REFERRERS_H
+
+#include <algorithm>
+#include <vector>
+
+/*
+**	Lists, for each object that can be targeted, the objects that may be holding it. A
+**	kind and heap ID picks the list. A list may also name objects that have since let go
+**	of the target, or even died, but never misses one that still holds it, so long as
+**	every write of a reference is reported through Add. Lists are pruned of the objects
+**	that let go whenever they grow to twice the size they were last pruned to.
+*/
+template <int KINDS, class T> class ReferrerTableClass
+{
+public:
+    typedef bool (*HoldsFunc)(T referrer, T target);
+
+    enum
+    {
+        MIN_LIMIT = 8 // size a list may always grow to before it is pruned
+    };
+
+    /*
+    **	Notes that the referrer may now be holding the target. The holds function tells
+    **	whether a listed referrer still does, for when the list is pruned.
+    */
+    void Add(int kind, unsigned id, T target, T referrer, HoldsFunc holds)
+    {
+        if (kind < 0 || kind >= KINDS) {
+            return;
+        }
+        if (id >= Lists[kind].size()) {
+            Lists[kind].resize(id + 1);
+        }
+
+        ListType& list = Lists[kind][id];
+        if (std::find(list.Referrers.begin(), list.Referrers.end(), referrer) != list.Referrers.end()) {
+            return;
+        }
+        if (list.Referrers.size() >= list.Limit) {
+            Prune(list, target, holds);
+        }
+        list.Referrers.push_back(referrer);
+    }
+
+    /*
+    **	Drops the referrers that no longer hold the target.
+    */
+    void Prune(int kind, unsigned id, T target, HoldsFunc holds)
+    {
+        if (kind >= 0 && kind < KINDS && id < Lists[kind].size()) {
+            Prune(Lists[kind][id], target, holds);
+        }
+    }
+
+    /*
+    **	The referrers listed for a target, or NULL if there are none. The list is only
+    **	good until the next call to Add.
+    */
+    std::vector<T> const* Get(int kind, unsigned id) const
+    {
+        if (kind < 0 || kind >= KINDS || id >= Lists[kind].size() || Lists[kind][id].Referrers.empty()) {
+            return (NULL);
+        }
+        return (&Lists[kind][id].Referrers);
+    }
+
+    bool Is_Listed(int kind, unsigned id, T referrer) const
+    {
+        std::vector<T> const* list = Get(kind, id);
+        return (list != NULL && std::find(list->begin(), list->end(), referrer) != list->end());
+    }
+
+    void Clear(void)
+    {
+        for (int kind = 0; kind < KINDS; kind++) {
+            Lists[kind].clear();
+        }
+    }
+
+private:
+    typedef struct ListStruct
+    {
+        ListStruct(void)
+            : Limit(MIN_LIMIT)
+        {
+        }
+
+        std::vector<T> Referrers;
+        size_t Limit;
+    } ListType;
+
+    static void Prune(ListType& list, T target, HoldsFunc holds)
+    {
+        size_t count = 0;
+        for (size_t index = 0; index < list.Referrers.size(); index++) {
+            if (holds(list.Referrers[index], target)) {
+                list.Referrers[count++] = list.Referrers[index];
+            }
+        }
+        list.Referrers.resize(count);
+        list.Limit = std::max((size_t)MIN_LIMIT, count * 2);
+    }
+
+    std::vector<ListType> Lists[KINDS];
+};
+
+#endif
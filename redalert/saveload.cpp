@@ -809,6 +809,14 @@ bool Load_Game(const char* file_name)
 
     file.Close();
     Decode_All_Pointers();
+
+    /*
+    **	Older saves hold padding where the cells now record their occupant types,
+    **	so rebuild them all from the decoded occupier chains.
+    */
+    for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
+        Map[cell].Recalc_Occupant_Types();
+    }
     Map.Init_IO();
     Map.Flag_To_Redraw(true);
 
@@ -817,6 +825,8 @@ bool Load_Game(const char* file_name)
     **	data loaded.
     */
     Post_Load_Game(load_net);
+    HouseClass::Scan_Rebuild();
+    Rebuild_Referrers();
 
     /*
     ** Re-init unit trackers. They will be garbage pointers after the load
@@ -0,0 +1,78 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef SCANCHANGE_H
+#define SCANCHANGE_H
+
+#include <string.h>
+
+/*
+**	Counts, for each house and kind of object, how often an object has joined or left
+**	the house. Anything that caches which objects a house owns compares the count with
+**	the one it was built with. An object's record is zero when it isn't counted,
+**	otherwise its owner plus one, along with any of the FLAGS bits, which don't
+**	change who owns it.
+*/
+template <int HOUSES, int KINDS, unsigned char FLAGS> class ScanChangeClass
+{
+public:
+    ScanChangeClass(void)
+    {
+        memset(Changes, 0, sizeof(Changes));
+    }
+
+    /*
+    **	Stores the object's new record. When that moves the object from one house to
+    **	another, both are counted as changed. Returns whether the record changed.
+    */
+    bool Set(int kind, unsigned char& record, unsigned char value)
+    {
+        if (value == record) {
+            return (false);
+        }
+
+        int from = (record & ~FLAGS) - 1;
+        int to = (value & ~FLAGS) - 1;
+        if (from != to) {
+            if (from >= 0) {
+                Changes[from][kind]++;
+            }
+            if (to >= 0) {
+                Changes[to][kind]++;
+            }
+        }
+
+        record = value;
+        return (true);
+    }
+
+    /*
+    **	Marks everything as changed, for when the records are thrown away.
+    */
+    void Change_All(void)
+    {
+        for (int house = 0; house < HOUSES; house++) {
+            for (int kind = 0; kind < KINDS; kind++) {
+                Changes[house][kind]++;
+            }
+        }
+    }
+
+    unsigned long Get(int house, int kind) const
+    {
+        return (Changes[house][kind]);
+    }
+
+private:
+    unsigned long Changes[HOUSES][KINDS];
+};
+
+#endif
@@ -800,6 +800,7 @@ void Clear_Scenario(void)
 
     HouseClass::Init();
     ObjectClass::Init();
+    Clear_Referrers();
     TeamTypeClass::Init();
     TeamClass::Init();
     TriggerClass::Init();
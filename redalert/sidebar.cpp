@@ -56,6 +56,8 @@
  *   SidebarClass::StripClass::Activate -- Adds the strip buttons to the input system.         *
  *   SidebarClass::StripClass::Add -- Add an object to the side strip.                         *
  *   SidebarClass::StripClass::Deactivate -- Removes the side strip buttons from the input syst*
+ *   SidebarClass::StripClass::Cameo_State -- Works out what a strip slot should show.         *
+ *   SidebarClass::StripClass::Draw_Cameo -- Draws one slot of the strip.                      *
  *   SidebarClass::StripClass::Draw_It -- Render the sidebar display.                          *
  *   SidebarClass::StripClass::Factory_Link -- Links a factory to a sidebar button.            *
  *   SidebarClass::StripClass::Flag_To_Redra -- Flags the sidebar strip to be redrawn.         *
@@ -87,6 +89,13 @@ void* SidebarClass::SidebarBottomShape = NULL;
 */
 char SidebarClass::StripClass::ClockTranslucentTable[(1 + 1) * 256];
 
+/***************************************************************************
+**	What each strip slot last drew on the page. A slot is only drawn again
+**	when its state changes, so a strip with one item building redraws that
+**	one cameo as its clock moves and leaves the others alone.
+*/
+CameoCacheClass<SidebarClass::StripClass::MAX_VISIBLE + 1> SidebarClass::StripClass::CameoCache[COLUMNS];
+
 /***************************************************************************
 **	This points to the main sidebar shapes. These include the upgrade and
 **	repair buttons.
@@ -745,8 +754,14 @@ void SidebarClass::Draw_It(bool complete)
 
     BStart(BENCH_SIDEBAR);
 
+    /*
+    **	The sidebar art goes under the strips, so they must be drawn whole over it.
+    */
+    bool strips = complete;
+
     if (IsSidebarActive && (IsToRedraw || complete) && !Debug_Map) {
         IsToRedraw = false;
+        strips = true;
 
         if (LogicPage->Lock()) {
             /*
@@ -774,8 +789,8 @@ void SidebarClass::Draw_It(bool complete)
     **	Draw the side strip elements by calling their respective draw functions.
     */
     if (IsSidebarActive) {
-        Column[0].Draw_It(complete);
-        Column[1].Draw_It(complete);
+        Column[0].Draw_It(strips);
+        Column[1].Draw_It(strips);
 
         if (complete || IsToRedraw) {
             Repair.Draw_Me(true);
@@ -1295,6 +1310,7 @@ void SidebarClass::StripClass::Reload_LogoShapes(void)
         houseloaded = PlayerPtr->ActLike;
     }
     LogoShapes = (void*)MFCD::Retrieve(stripnames[houseloaded]);
+    CameoCache[ID].Forget();
 }
 
 /***********************************************************************************************
@@ -1648,6 +1664,30 @@ void SidebarClass::StripClass::Draw_It(bool complete)
 
         SidebarRedraws++;
 
+        /*
+        **	Work out what each slot should show before anything is drawn, so that it is known
+        **	which of them differ from what is already on the page.
+        */
+        CameoStateType cameo[MAX_VISIBLE + 1];
+        bool changed[MAX_VISIBLE + 1];
+        int slots = MAX_VISIBLE + (IsScrolling ? 1 : 0);
+
+        for (int i = 0; i < slots; i++) {
+            Cameo_State(i, cameo[i]);
+        }
+
+        /*
+        **	Every slot is drawn when the strip is forced, is scrolling, or is drawing to a
+        **	different page than this strip last drew on. The background under a short strip
+        **	covers all of the slots, so one of them changing means drawing them all again too.
+        */
+        bool all = CameoCache[ID].Update(cameo,
+                                         slots,
+                                         LogicPage,
+                                         complete || IsScrolling || LastSlid != Slid,
+                                         BuildableCount < MAX_VISIBLE,
+                                         changed);
+
         /*
         **	Fills the background to the side strip. We shouldnt need to do this if the strip
         ** has a full complement of icons.
@@ -1655,7 +1695,7 @@ void SidebarClass::StripClass::Draw_It(bool complete)
         /*
         ** New sidebar needs to be drawn not filled
         */
-        if (BuildableCount < MAX_VISIBLE) {
+        if (BuildableCount < MAX_VISIBLE && all) {
             CC_Draw_Shape(LogoShapes, ID, X + (2 * RESFACTOR), Y, WINDOW_MAIN, SHAPE_WIN_REL | SHAPE_NORMAL, 0);
         }
 
@@ -1667,198 +1707,260 @@ void SidebarClass::StripClass::Draw_It(bool complete)
 
         /*
         **	Loop through all the buildable objects that are visible in the strip and render
-        **	them. Their Y offset may be adjusted if the strip is in the process of scrolling.
+        **	the ones that look different from when they were last drawn.
         */
-        for (int i = 0; i < MAX_VISIBLE + (IsScrolling ? 1 : 0); i++) {
-            bool production;
-            bool completed;
-            int stage;
-            bool darken = false;
-            void const* shapefile = 0;
-            int shapenum = 0;
-            void const* remapper = 0;
-            FactoryClass* factory = 0;
-            int index = i + TopIndex;
-            int x = X;
-            int y = Y + (i * OBJECT_HEIGHT * RESFACTOR);
-
-            /*
-            **	If the strip is scrolling, then the offset is adjusted accordingly.
-            */
-            if (IsScrolling) {
-                y -= (OBJECT_HEIGHT - Slid) * RESFACTOR;
-                //				y -= OBJECT_HEIGHT - Slid;
+        for (int i = 0; i < slots; i++) {
+            if (changed[i]) {
+                Draw_Cameo(cameo[i]);
             }
+        }
 
-            /*
-            **	Fetch the shape number for the object type located at this current working
-            **	slot. This shape pointer is used to draw the underlying graphic there.
-            */
-            if (index < BuildableCount) {
-                ObjectTypeClass const* obj = NULL;
-                SpecialWeaponType spc = SPC_NONE;
+        LastSlid = Slid;
+    }
+}
 
-                if (Buildables[index].BuildableType != RTTI_SPECIAL) {
+/***********************************************************************************************
+ * SidebarClass::StripClass::Cameo_State -- Works out what a strip slot should show.           *
+ *                                                                                             *
+ *    This fetches the cameo, darkening, construction clock stage and ready or on hold text    *
+ *    for one of the visible slots of the strip. Slots with the same state look the same on    *
+ *    the page, so a slot only needs drawing again when its state changes.                     *
+ *                                                                                             *
+ * INPUT:   i     -- The visible slot, counting from the top of the strip.                     *
+ *                                                                                             *
+ *          state -- Reference to the state to fill in.                                        *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *   12/31/1994 JLB : Created.                                                                 *
+ *=============================================================================================*/
+void SidebarClass::StripClass::Cameo_State(int i, CameoStateType& state)
+{
+    bool production = false;
+    bool completed = false;
+    int stage = 0;
+    bool darken = false;
+    void const* shapefile = 0;
+    int shapenum = 0;
+    void const* remapper = 0;
+    FactoryClass* factory = 0;
+    int index = i + TopIndex;
+    int x = X;
+    int y = Y + (i * OBJECT_HEIGHT * RESFACTOR);
 
-                    obj = Fetch_Techno_Type(Buildables[index].BuildableType, Buildables[index].BuildableID);
-                    if (obj != NULL) {
+    /*
+    **	If the strip is scrolling, then the offset is adjusted accordingly.
+    */
+    if (IsScrolling) {
+        y -= (OBJECT_HEIGHT - Slid) * RESFACTOR;
+        //		y -= OBJECT_HEIGHT - Slid;
+    }
 
-                        /*
-                        **	Fetch the remap table that is appropriate for this object
-                        **	type.
-                        */
-                        remapper = PlayerPtr->Remap_Table(false, ((TechnoTypeClass const*)obj)->Remap);
+    /*
+    **	Fetch the shape number for the object type located at this current working
+    **	slot. This shape pointer is used to draw the underlying graphic there.
+    */
+    if (index < BuildableCount) {
+        ObjectTypeClass const* obj = NULL;
+        SpecialWeaponType spc = SPC_NONE;
 
-                        /*
-                        **	If there is already a factory producing this kind of object, then all
-                        **	objects of this type are displays in a disabled state.
-                        */
-                        bool isbusy = (PlayerPtr->Fetch_Factory(Buildables[index].BuildableType) != NULL);
-                        if (!isbusy
-                            && PlayerPtr->Is_Hack_Prevented(Buildables[index].BuildableType,
-                                                            Buildables[index].BuildableID)) {
-                            isbusy = true;
-                        }
+        if (Buildables[index].BuildableType != RTTI_SPECIAL) {
 
-                        /*
-                        **	Infantry don't get remapped in the sidebar (special case).
-                        */
-                        if (Buildables[index].BuildableType == RTTI_INFANTRYTYPE) {
-                            remapper = 0;
-                        }
+            obj = Fetch_Techno_Type(Buildables[index].BuildableType, Buildables[index].BuildableID);
+            if (obj != NULL) {
 
-                        shapefile = obj->Get_Cameo_Data();
-                        shapenum = 0;
-                        if (Buildables[index].Factory != -1) {
-                            factory = Factories.Raw_Ptr(Buildables[index].Factory);
-                            production = true;
-                            completed = factory->Has_Completed();
-                            stage = factory->Completion();
-                            darken = false;
-                        } else {
-                            production = false;
-                            //							darken      = IsBuilding;
-
-                            /*
-                            **	Darken the imagery if a factory of a matching type is
-                            **	already busy.
-                            */
-                            darken = isbusy;
-                        }
-                    } else {
-                        darken = PlayerPtr->Is_Hack_Prevented(Buildables[index].BuildableType,
-                                                              Buildables[index].BuildableID);
-                    }
+                /*
+                **	Fetch the remap table that is appropriate for this object
+                **	type.
+                */
+                remapper = PlayerPtr->Remap_Table(false, ((TechnoTypeClass const*)obj)->Remap);
 
-                } else {
+                /*
+                **	If there is already a factory producing this kind of object, then all
+                **	objects of this type are displays in a disabled state.
+                */
+                bool isbusy = (PlayerPtr->Fetch_Factory(Buildables[index].BuildableType) != NULL);
+                if (!isbusy
+                    && PlayerPtr->Is_Hack_Prevented(Buildables[index].BuildableType,
+                                                    Buildables[index].BuildableID)) {
+                    isbusy = true;
+                }
 
-                    spc = SpecialWeaponType(Buildables[index].BuildableID);
-                    shapefile = Get_Special_Cameo(spc);
-                    shapenum = 0;
+                /*
+                **	Infantry don't get remapped in the sidebar (special case).
+                */
+                if (Buildables[index].BuildableType == RTTI_INFANTRYTYPE) {
+                    remapper = 0;
+                }
 
+                shapefile = obj->Get_Cameo_Data();
+                shapenum = 0;
+                if (Buildables[index].Factory != -1) {
+                    factory = Factories.Raw_Ptr(Buildables[index].Factory);
                     production = true;
-                    completed = PlayerPtr->SuperWeapon[spc].Is_Ready();
-                    stage = PlayerPtr->SuperWeapon[spc].Anim_Stage();
+                    completed = factory->Has_Completed();
+                    stage = factory->Completion();
                     darken = false;
-                }
+                } else {
+                    production = false;
+                    //							darken      = IsBuilding;
 
-                if (obj != NULL || spc != SPC_NONE) {
                     /*
-                    ** If this item is flashing then take care of it.
-                    **
+                    **	Darken the imagery if a factory of a matching type is
+                    **	already busy.
                     */
-                    if (Flasher == index && (Fetch_Stage() & 0x01)) {
-                        remapper = Map.FadingLight;
-                    }
-
-                } else {
-                    shapefile = LogoShapes;
-                    if (!darken) {
-                        shapenum = SB_BLANK;
-                    }
+                    darken = isbusy;
                 }
             } else {
-                shapefile = LogoShapes;
-                shapenum = SB_BLANK;
-                production = false;
+                darken = PlayerPtr->Is_Hack_Prevented(Buildables[index].BuildableType,
+                                                      Buildables[index].BuildableID);
             }
 
-            remapper = 0;
+        } else {
+
+            spc = SpecialWeaponType(Buildables[index].BuildableID);
+            shapefile = Get_Special_Cameo(spc);
+            shapenum = 0;
+
+            production = true;
+            completed = PlayerPtr->SuperWeapon[spc].Is_Ready();
+            stage = PlayerPtr->SuperWeapon[spc].Anim_Stage();
+            darken = false;
+        }
 
+        if (obj != NULL || spc != SPC_NONE) {
             /*
-            **	Now that the shape of the object at the current working slot has been found,
-            **	draw it and any graphic overlays as necessary.
+            ** If this item is flashing then take care of it.
             **
-            ** Don't draw blank shapes over the new 640x400 sidebar art - ST 5/1/96 6:01PM
             */
-            if (shapenum != SB_BLANK || shapefile != LogoShapes) {
-                CC_Draw_Shape(shapefile,
-                              shapenum,
-                              x - (WindowList[WINDOW_SIDEBAR][WINDOWX]) + (LEFT_EDGE_OFFSET * RESFACTOR),
-                              y - WindowList[WINDOW_SIDEBAR][WINDOWY],
-                              WINDOW_SIDEBAR,
-                              SHAPE_NORMAL | SHAPE_WIN_REL | (remapper ? SHAPE_FADING : SHAPE_NORMAL),
-                              remapper);
+            if (Flasher == index && (Fetch_Stage() & 0x01)) {
+                remapper = Map.FadingLight;
+            }
 
-                /*
-                **	Darken this object because it cannot be produced or is otherwise
-                **	unavailable.
-                */
-                if (darken) {
-                    CC_Draw_Shape(ClockShapes,
-                                  0,
-                                  x - (WindowList[WINDOW_SIDEBAR][WINDOWX]) + (LEFT_EDGE_OFFSET * RESFACTOR),
-                                  y - WindowList[WINDOW_SIDEBAR][WINDOWY],
-                                  WINDOW_SIDEBAR,
-                                  SHAPE_NORMAL | SHAPE_WIN_REL | SHAPE_GHOST,
-                                  NULL,
-                                  ClockTranslucentTable);
-                }
+        } else {
+            shapefile = LogoShapes;
+            if (!darken) {
+                shapenum = SB_BLANK;
             }
+        }
+    } else {
+        shapefile = LogoShapes;
+        shapenum = SB_BLANK;
+        production = false;
+    }
+
+
+    remapper = 0;
+
+    /*
+    **	Only what is drawn goes into the state, so that states can be compared whole.
+    */
+    memset(&state, 0, sizeof(state));
+    state.Shape = shapefile;
+    state.ShapeNum = shapenum;
+    state.Remap = remapper;
+    state.X = x - WindowList[WINDOW_SIDEBAR][WINDOWX];
+    state.Y = y - WindowList[WINDOW_SIDEBAR][WINDOWY];
+    state.IsDark = darken;
+    state.IsProducing = production;
+    if (production) {
+        state.IsCompleted = completed;
+        if (!completed) {
+            state.Stage = stage;
+            state.IsHolding = (factory != NULL && !factory->Is_Building());
+        }
+    }
+}
+
+/***********************************************************************************************
+ * SidebarClass::StripClass::Draw_Cameo -- Draws one slot of the strip.                        *
+ *                                                                                             *
+ *    This draws the cameo for a slot along with any darkening, construction clock and ready   *
+ *    or on hold text over it.                                                                 *
+ *                                                                                             *
+ * INPUT:   state -- The slot state as worked out by Cameo_State.                              *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *   12/31/1994 JLB : Created.                                                                 *
+ *=============================================================================================*/
+void SidebarClass::StripClass::Draw_Cameo(CameoStateType const& state) const
+{
+    /*
+    **	Now that the shape of the object at the current working slot has been found,
+    **	draw it and any graphic overlays as necessary.
+    **
+    ** Don't draw blank shapes over the new 640x400 sidebar art - ST 5/1/96 6:01PM
+    */
+    if (state.ShapeNum != SB_BLANK || state.Shape != LogoShapes) {
+        CC_Draw_Shape(state.Shape,
+                      state.ShapeNum,
+                      state.X + (LEFT_EDGE_OFFSET * RESFACTOR),
+                      state.Y,
+                      WINDOW_SIDEBAR,
+                      SHAPE_NORMAL | SHAPE_WIN_REL | (state.Remap ? SHAPE_FADING : SHAPE_NORMAL),
+                      state.Remap);
+
+        /*
+        **	Darken this object because it cannot be produced or is otherwise
+        **	unavailable.
+        */
+        if (state.IsDark) {
+            CC_Draw_Shape(ClockShapes,
+                          0,
+                          state.X + (LEFT_EDGE_OFFSET * RESFACTOR),
+                          state.Y,
+                          WINDOW_SIDEBAR,
+                          SHAPE_NORMAL | SHAPE_WIN_REL | SHAPE_GHOST,
+                          NULL,
+                          ClockTranslucentTable);
+        }
+    }
+
+    /*
+    **	Draw the overlapping clock shape if this is object is being constructed.
+    **	If the object is completed, then display "Ready" with no clock shape.
+    */
+    if (state.IsProducing) {
+        if (state.IsCompleted) {
 
             /*
-            **	Draw the overlapping clock shape if this is object is being constructed.
-            **	If the object is completed, then display "Ready" with no clock shape.
+            **	Display text showing that the object is ready to place.
             */
-            if (production) {
-                if (completed) {
-
-                    /*
-                    **	Display text showing that the object is ready to place.
-                    */
-                    CC_Draw_Shape(ObjectTypeClass::PipShapes,
-                                  PIP_READY,
-                                  (x - (WindowList[WINDOW_SIDEBAR][WINDOWX])) + (LEFT_EDGE_OFFSET + 15) * RESFACTOR,
-                                  (y - WindowList[WINDOW_SIDEBAR][WINDOWY]) + (4 * RESFACTOR),
-                                  WINDOW_SIDEBAR,
-                                  SHAPE_CENTER);
-                } else {
-                    CC_Draw_Shape(ClockShapes,
-                                  stage + 1,
-                                  x - (WindowList[WINDOW_SIDEBAR][WINDOWX]) + (LEFT_EDGE_OFFSET * RESFACTOR),
-                                  y - WindowList[WINDOW_SIDEBAR][WINDOWY],
-                                  WINDOW_SIDEBAR,
-                                  SHAPE_NORMAL | SHAPE_WIN_REL | SHAPE_GHOST,
-                                  NULL,
-                                  ClockTranslucentTable);
+            CC_Draw_Shape(ObjectTypeClass::PipShapes,
+                          PIP_READY,
+                          state.X + (LEFT_EDGE_OFFSET + 15) * RESFACTOR,
+                          state.Y + (4 * RESFACTOR),
+                          WINDOW_SIDEBAR,
+                          SHAPE_CENTER);
+        } else {
+            CC_Draw_Shape(ClockShapes,
+                          state.Stage + 1,
+                          state.X + (LEFT_EDGE_OFFSET * RESFACTOR),
+                          state.Y,
+                          WINDOW_SIDEBAR,
+                          SHAPE_NORMAL | SHAPE_WIN_REL | SHAPE_GHOST,
+                          NULL,
+                          ClockTranslucentTable);
 
-                    /*
-                    **	Display text showing that the construction is temporarily on hold.
-                    */
-                    if (factory && !factory->Is_Building()) {
-                        CC_Draw_Shape(ObjectTypeClass::PipShapes,
-                                      PIP_HOLDING,
-                                      (x - (WindowList[WINDOW_SIDEBAR][WINDOWX]))
-                                          + ((LEFT_EDGE_OFFSET + 15) * RESFACTOR),
-                                      (y - WindowList[WINDOW_SIDEBAR][WINDOWY]) + (4 * RESFACTOR),
-                                      WINDOW_SIDEBAR,
-                                      SHAPE_CENTER);
-                    }
-                }
+            /*
+            **	Display text showing that the construction is temporarily on hold.
+            */
+            if (state.IsHolding) {
+                CC_Draw_Shape(ObjectTypeClass::PipShapes,
+                              PIP_HOLDING,
+                              state.X + ((LEFT_EDGE_OFFSET + 15) * RESFACTOR),
+                              state.Y + (4 * RESFACTOR),
+                              WINDOW_SIDEBAR,
+                              SHAPE_CENTER);
             }
         }
-
-        LastSlid = Slid;
     }
 }
 
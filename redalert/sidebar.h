@@ -41,6 +41,7 @@
 #include "control.h"
 #include "shapebtn.h"
 #include "stage.h"
+#include "cameocache.h"
 
 class Pipe;
 class Straw;
@@ -347,6 +348,15 @@ public:
         */
         static char ClockTranslucentTable[(1 + 1) * 256];
 
+        void Cameo_State(int i, CameoStateType& state);
+        void Draw_Cameo(CameoStateType const& state) const;
+
+        /*
+        **	What each strip last drew in its slots. These are static so that they don't take
+        **	part in saved games.
+        */
+        static CameoCacheClass<MAX_VISIBLE + 1> CameoCache[COLUMNS];
+
     } Column[COLUMNS];
 
     /*
@@ -80,6 +80,7 @@ void SpecialClass::Init(void)
     IsMCVDeploy = false;
     IsEarlyWin = false;
     ModernBalance = false;
+    IsParallelThink = false;
 }
 
 /***********************************************************************************************
@@ -104,6 +104,13 @@ public:
     */
     unsigned ModernBalance : 1;
 
+    /*
+    **	If the objects' threat scans are worked out on the job system at the start of
+    **	each frame, then this flag will be true. It changes which targets are picked,
+    **	so every player in a game must have the same setting.
+    */
+    unsigned IsParallelThink : 1;
+
     /*
     ** Some additional padding in case we need to add data to the class and maintain backwards compatibility for
     *save/load
@@ -701,6 +701,7 @@ void Read_Setup_Options(RawFileClass* config_file)
     ** Read in global settings
     */
     Settings.Load(ini);
+    LogicClass::Init_Telemetry();
 
     /*
     ** Read in the boolean options
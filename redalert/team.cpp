@@ -70,6 +70,7 @@
  *   TeamClass::~TeamClass -- Team object destructor.                                          *
  *   _Is_It_Breathing -- Checks to see if unit is an active team member.                       *
  *   _Is_It_Playing -- Determines if unit is active and an initiated team member.              *
+ *   _Owned_Pool -- Fetches the objects of one kind that a house owns.                         *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
@@ -161,6 +162,117 @@ static inline bool _Is_It_Playing(FootClass const* object)
     return (true);
 }
 
+/*
+**	The infantry, aircraft, units, vessels and buildings each house owns, in heap order. A
+**	sweep of a pool meets the house's objects in the same order as a sweep of the whole heap
+**	would, so recruiting from it picks exactly the same members.
+*/
+typedef enum OwnedPoolType
+{
+    OWNED_INFANTRY,
+    OWNED_AIRCRAFT,
+    OWNED_UNIT,
+    OWNED_VESSEL,
+    OWNED_BUILDING,
+    OWNED_COUNT
+} OwnedPoolType;
+
+static DynamicVectorClass<TechnoClass*> _OwnedPool[OWNED_COUNT][HOUSE_COUNT];
+static unsigned long _OwnedChanges[OWNED_COUNT][HOUSE_COUNT];
+static bool _OwnedIsValid[OWNED_COUNT][HOUSE_COUNT];
+
+/***********************************************************************************************
+ * _Owned_Pool -- Fetches the objects of one kind that a house owns.                           *
+ *                                                                                             *
+ *    A house's pool of a kind is sorted out again from its heap only when an object of that   *
+ *    kind has joined or left the house since it was last made. Changes to other houses, or to *
+ *    other kinds, leave it alone.                                                             *
+ *                                                                                             *
+ * INPUT:   pool  -- The kind of object wanted.                                                *
+ *                                                                                             *
+ *          house -- The house that owns them.                                                 *
+ *                                                                                             *
+ * OUTPUT:  Returns with the house's objects of that kind, in heap order.                      *
+ *                                                                                             *
+ * WARNINGS:   The list is only good until the next object is made, destroyed or captured.     *
+ *=============================================================================================*/
+static DynamicVectorClass<TechnoClass*> const& _Owned_Pool(OwnedPoolType pool, HousesType house)
+{
+    static RTTIType const _rtti[OWNED_COUNT] = {RTTI_INFANTRY, RTTI_AIRCRAFT, RTTI_UNIT, RTTI_VESSEL, RTTI_BUILDING};
+
+    unsigned long changes = HouseClass::Scan_Changes(house, _rtti[pool]);
+
+    if (!_OwnedIsValid[pool][house] || _OwnedChanges[pool][house] != changes) {
+        DynamicVectorClass<TechnoClass*>& owned = _OwnedPool[pool][house];
+        int count = 0;
+
+        switch (pool) {
+        case OWNED_INFANTRY:
+            count = Infantry.Count();
+            break;
+
+        case OWNED_AIRCRAFT:
+            count = Aircraft.Count();
+            break;
+
+        case OWNED_UNIT:
+            count = Units.Count();
+            break;
+
+        case OWNED_VESSEL:
+            count = Vessels.Count();
+            break;
+
+        case OWNED_BUILDING:
+            count = Buildings.Count();
+            break;
+
+        default:
+            break;
+        }
+
+        owned.Delete_All();
+
+        for (int index = 0; index < count; index++) {
+            TechnoClass* obj = NULL;
+
+            switch (pool) {
+            case OWNED_INFANTRY:
+                obj = Infantry.Ptr(index);
+                break;
+
+            case OWNED_AIRCRAFT:
+                obj = Aircraft.Ptr(index);
+                break;
+
+            case OWNED_UNIT:
+                obj = Units.Ptr(index);
+                break;
+
+            case OWNED_VESSEL:
+                obj = Vessels.Ptr(index);
+                break;
+
+            case OWNED_BUILDING:
+                obj = Buildings.Ptr(index);
+                break;
+
+            default:
+                break;
+            }
+
+            if (obj != NULL && obj->Owner() == house) {
+                owned.Add(obj);
+            }
+        }
+
+        _OwnedChanges[pool][house] = changes;
+        _OwnedIsValid[pool][house] = true;
+    }
+
+    return (_OwnedPool[pool][house]);
+}
+
 #ifdef CHEAT_KEYS
 /***********************************************************************************************
  * TeamClass::Debug_Dump -- Displays debug information about the team.                         *
@@ -588,10 +700,12 @@ void TeamClass::AI(void)
             CELL dest = As_Cell(Zone);
             int max = 0x7FFFFFFF;
 
-            for (int index = 0; index < Buildings.Count(); index++) {
-                BuildingClass* b = Buildings.Ptr(index);
+            DynamicVectorClass<TechnoClass*> const& buildings = _Owned_Pool(OWNED_BUILDING, House->Class->House);
+
+            for (int index = 0; index < buildings.Count(); index++) {
+                BuildingClass* b = (BuildingClass*)buildings[index];
 
-                if (b != NULL && !b->IsInLimbo && b->House == House && b->Class->PrimaryWeapon == NULL) {
+                if (!b->IsInLimbo && b->Class->PrimaryWeapon == NULL) {
                     CELL cell = Coord_Cell(b->Center_Coord());
                     int dist = ::Distance(b->Center_Coord(), As_Coord(Zone))
                                * (Map.Cell_Threat(cell, House->Class->House) + 1);
@@ -1203,8 +1317,10 @@ int TeamClass::Recruit(int typeindex)
             InfantryClass* best = 0;
             int bestdist = -1;
 
-            for (int index = 0; index < Infantry.Count(); index++) {
-                InfantryClass* infantry = Infantry.Ptr(index);
+            DynamicVectorClass<TechnoClass*> const& pool = _Owned_Pool(OWNED_INFANTRY, House->Class->House);
+
+            for (int index = 0; index < pool.Count(); index++) {
+                InfantryClass* infantry = (InfantryClass*)pool[index];
                 int d = infantry->Distance(center);
 
                 if ((d < bestdist || bestdist == -1) && Can_Add(infantry, typeindex)) {
@@ -1225,8 +1341,10 @@ int TeamClass::Recruit(int typeindex)
             AircraftClass* best = 0;
             int bestdist = -1;
 
-            for (int index = 0; index < Aircraft.Count(); index++) {
-                AircraftClass* aircraft = Aircraft.Ptr(index);
+            DynamicVectorClass<TechnoClass*> const& pool = _Owned_Pool(OWNED_AIRCRAFT, House->Class->House);
+
+            for (int index = 0; index < pool.Count(); index++) {
+                AircraftClass* aircraft = (AircraftClass*)pool[index];
                 int d = aircraft->Distance(center);
 
                 if ((d < bestdist || bestdist == -1) && Can_Add(aircraft, typeindex)) {
@@ -1247,8 +1365,10 @@ int TeamClass::Recruit(int typeindex)
             UnitClass* best = 0;
             int bestdist = -1;
 
-            for (int index = 0; index < Units.Count(); index++) {
-                UnitClass* unit = Units.Ptr(index);
+            DynamicVectorClass<TechnoClass*> const& pool = _Owned_Pool(OWNED_UNIT, House->Class->House);
+
+            for (int index = 0; index < pool.Count(); index++) {
+                UnitClass* unit = (UnitClass*)pool[index];
                 int d = unit->Distance(center);
 
                 if (unit->House == House && unit->Class == Class->Members[typeindex].Class) {
@@ -1282,8 +1402,10 @@ int TeamClass::Recruit(int typeindex)
             VesselClass* best = 0;
             int bestdist = -1;
 
-            for (int index = 0; index < Vessels.Count(); index++) {
-                VesselClass* vessel = Vessels.Ptr(index);
+            DynamicVectorClass<TechnoClass*> const& pool = _Owned_Pool(OWNED_VESSEL, House->Class->House);
+
+            for (int index = 0; index < pool.Count(); index++) {
+                VesselClass* vessel = (VesselClass*)pool[index];
                 int d = vessel->Distance(center);
 
                 if (vessel->House == House && vessel->Class == Class->Members[typeindex].Class) {
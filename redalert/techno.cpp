@@ -782,6 +782,7 @@ bool TechnoClass::Revealed(HouseClass* house)
         if (Session.Type == GAME_NORMAL) {
             if (house == PlayerPtr) {
                 IsDiscoveredByPlayer = true;
+                HouseClass::Scan_Update(this);
 
                 if (!IsOwnedByPlayer) {
 
@@ -1089,6 +1090,7 @@ void TechnoClass::Per_Cell_Process(PCPType why)
         */
         if (!IsLocked && Map.In_Radar(cell)) {
             IsLocked = true;
+            HouseClass::Scan_Update(this);
         }
 
         /*
@@ -1275,6 +1277,7 @@ bool TechnoClass::Unlimbo(COORDINATE coord, DirType dir)
         Commence();
 
         IsLocked = Map.In_Radar(Coord_Cell(coord));
+        HouseClass::Scan_Update(this);
         return (true);
     }
     return (false);
@@ -2129,7 +2132,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
         int bestval = -1;
         int zone = -1;
 
-        TargetScan++;
+        TargetScan.fetch_add(1, std::memory_order_relaxed);
 
         /*
         **	Determine the zone that the target must be in. For aircraft and gunboats, they
@@ -3028,6 +3031,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
         **	Set the unit's targeting computer.
         */
         TarCom = target;
+        Add_Referrer(TarCom, As_Target());
     }
 
     /***********************************************************************************************
@@ -3932,6 +3936,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
         assert(IsActive);
 
         SuspendedTarCom = TarCom;
+        Add_Referrer(SuspendedTarCom, As_Target());
         RadioClass::Override_Mission(mission, tarcom, navcom);
         Assign_Target(tarcom);
     }
@@ -4054,6 +4059,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
             */
             House = newowner;
             IsOwnedByPlayer = (House == PlayerPtr);
+            HouseClass::Scan_Update(this);
 
             return (true);
         }
@@ -5528,6 +5534,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
                 } else {
                     defender[lp]->Assign_Mission(MISSION_GUARD_AREA);
                     defender[lp]->ArchiveTarget = As_Target();
+                    Add_Referrer(defender[lp]->ArchiveTarget, defender[lp]->As_Target());
                 }
                 defender[lp]->Assign_Target(enemy->As_Target());
                 risktotal += defender[lp]->Risk();
@@ -5923,7 +5930,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
         **	the target for this unit.
         */
         if (!Target_Legal(TarCom)) {
-            Assign_Target(Greatest_Threat(threat));
+            Assign_Target(Logic.Greatest_Threat(this, threat));
         }
 
         /*
@@ -7175,6 +7182,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
 
         if (Session.Type != GAME_GLYPHX_MULTIPLAYER && player == PlayerPtr) {
             IsDiscoveredByPlayer = true;
+            HouseClass::Scan_Update(this);
         }
     }
 
@@ -7194,6 +7202,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
     {
         IsDiscoveredByPlayerMask = 0;
         IsDiscoveredByPlayer = false;
+        HouseClass::Scan_Update(this);
     }
 
     /***********************************************************************************************
@@ -135,6 +135,7 @@ bool TemplateClass::Mark(MarkType mark)
                             cellptr->Smudge = SMUDGE_NONE;
                             cellptr->SmudgeData = 0;
                             cellptr->Overlay = OVERLAY_NONE;
+                            cellptr->Sync_Overlay();
                             cellptr->OverlayData = 0;
                         }
 
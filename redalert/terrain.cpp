@@ -617,6 +617,7 @@ bool TerrainClass::Limbo(void)
     if (!IsInLimbo) {
         CELL cell = Coord_Cell(Coord);
         Map[cell].Flag.Occupy.Monolith = false;
+        Map[cell].Sync_Occupy();
     }
     return (ObjectClass::Limbo());
 }
@@ -36,6 +36,7 @@
  *   Event_Needs -- Returns with what this event type needs for data.                          *
  *   Name_From_Event -- retrieves name for EventType                                           *
  *   TEventClass::Build_INI_Entry -- Builds the ini text for this event.                       *
+ *   TEventClass::Is_Quiet -- Can this event be ruled out without evaluating it?               *
  *   TEventClass::Read_INI -- Parses the INI text for this event's data.                       *
  *   TEventClass::Reset -- Reset the trigger for a subsequent "spring".                        *
  *   TEventClass::operator () -- Action operator to see if event is satisfied.                 *
@@ -490,6 +491,62 @@ bool TEventClass::operator()(TDEventClass& td,
     return (true);
 }
 
+/***********************************************************************************************
+ * TEventClass::Is_Quiet -- Can this event be ruled out without evaluating it?                 *
+ *                                                                                             *
+ *    Checks the cheap cases where the event operator is certain to return false without       *
+ *    tripping the event: an unexpired timer, a global flag in the wrong state, standing       *
+ *    bridges, or an object/cell event called for some other event. All other events have      *
+ *    to be evaluated, so they are never quiet.                                                *
+ *                                                                                             *
+ * INPUT:   td    -- Reference to the trigger's dynamic data for this event.                   *
+ *                                                                                             *
+ *          event -- The event that is about to be passed to the event operator.               *
+ *                                                                                             *
+ * OUTPUT:  Is the event operator sure to fail with no side effects?                           *
+ *                                                                                             *
+ * WARNINGS:   This must agree with the event operator, it takes the same early exits.         *
+ *=============================================================================================*/
+bool TEventClass::Is_Quiet(TDEventClass const& td, TEventType event) const
+{
+    if (td.IsTripped)
+        return (false);
+
+    switch (Event) {
+    case TEVENT_GLOBAL_SET:
+        return (!Scen.GlobalFlags[Data.Value]);
+
+    case TEVENT_GLOBAL_CLEAR:
+        return (Scen.GlobalFlags[Data.Value]);
+
+    case TEVENT_MISSION_TIMER_EXPIRED:
+        return (!Scen.MissionTimer.Is_Active() || Scen.MissionTimer != 0);
+
+    case TEVENT_TIME:
+        return (td.Timer != 0);
+
+    case TEVENT_NONE:
+        return (true);
+
+    case TEVENT_ATTACKED:
+    case TEVENT_DESTROYED:
+    case TEVENT_DISCOVERED:
+    case TEVENT_SPIED:
+    case TEVENT_CROSS_HORIZONTAL:
+    case TEVENT_CROSS_VERTICAL:
+    case TEVENT_ENTERS_ZONE:
+    case TEVENT_PLAYER_ENTERED:
+        return (event != Event && event != TEVENT_ANY);
+
+    case TEVENT_ALL_BRIDGES_DESTROYED:
+        return (Scen.BridgeCount != 0);
+
+    default:
+        break;
+    }
+    return (false);
+}
+
 /***********************************************************************************************
  * TEventClass::Build_INI_Entry -- Builds the ini text for this event.                         *
  *                                                                                             *
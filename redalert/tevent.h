@@ -157,6 +157,7 @@ struct TEventClass
     void Decode_Pointers(void);
     void Reset(TDEventClass& td) const;
     bool operator()(TDEventClass& td, TEventType event, HousesType house, ObjectClass const* object, bool forced);
+    bool Is_Quiet(TDEventClass const& td, TEventType event) const;
     void Read_INI(void);
     void Build_INI_Entry(char* buffer) const;
 };
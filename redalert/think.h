@@ -0,0 +1,83 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef THINK_H
+#define THINK_H
+
+#include <vector>
+
+/*
+**	Scratch results of a think phase, one per object, picked by kind and heap ID. The
+**	workers of the phase work the results out into their own buffers and the table is
+**	filled in from those afterwards, on one thread. A result is only handed out in the
+**	frame it was worked out for, and only if the inputs it was worked out from (the
+**	CHECK value) still match, so anything that has changed since is worked out again.
+**	Each result is handed out just once.
+*/
+template <int KINDS, class CHECK, class RESULT> class ThinkTableClass
+{
+public:
+    void Put(int kind, unsigned id, long frame, CHECK const& check, RESULT const& result)
+    {
+        if (kind < 0 || kind >= KINDS) {
+            return;
+        }
+        if (id >= Slots[kind].size()) {
+            Slots[kind].resize(id + 1);
+        }
+
+        SlotType& slot = Slots[kind][id];
+        slot.Frame = frame;
+        slot.Check = check;
+        slot.Result = result;
+    }
+
+    bool Take(int kind, unsigned id, long frame, CHECK const& check, RESULT& result)
+    {
+        if (kind < 0 || kind >= KINDS || id >= Slots[kind].size()) {
+            return (false);
+        }
+
+        SlotType& slot = Slots[kind][id];
+        if (slot.Frame != frame || !(slot.Check == check)) {
+            return (false);
+        }
+        slot.Frame = -1;
+        result = slot.Result;
+        return (true);
+    }
+
+    void Clear(void)
+    {
+        for (int kind = 0; kind < KINDS; kind++) {
+            Slots[kind].clear();
+        }
+    }
+
+private:
+    typedef struct SlotStruct
+    {
+        SlotStruct(void)
+            : Frame(-1)
+            , Check()
+            , Result()
+        {
+        }
+
+        long Frame;
+        CHECK Check;
+        RESULT Result;
+    } SlotType;
+
+    std::vector<SlotType> Slots[KINDS];
+};
+
+#endif
@@ -30,10 +30,229 @@
  *                                                                                             *
  *---------------------------------------------------------------------------------------------*
  * Functions:                                                                                  *
+ *   Add_Referrer -- Notes that an object may now be holding a target.                         *
+ *   Clear_Referrers -- Forgets every object noted as holding a target.                        *
  *   Detach_This_From_All -- Detaches this object from all others.                             *
+ *   Rebuild_Referrers -- Notes every target held by every object from scratch.                *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
+#include "referrers.h"
+
+/*
+**	For each object or animation, the game objects that may be holding it as a target,
+**	destination, radio contact or the like. Only a target's own list needs visiting when
+**	it goes away, rather than every object on the map.
+*/
+static ReferrerTableClass<RTTI_COUNT, TARGET> _Referrers;
+
+/*
+**	Does the referrer hold the target in any of the fields that its Detach function
+**	checks? The fields are compared whatever state the referrer is in, so that an
+**	object is listed for as long as its Detach could ever act on the target.
+*/
+static bool Holds_Target(TARGET referrer, TARGET target)
+{
+    TechnoClass const* techno = As_Techno(referrer);
+    if (techno == NULL) {
+        return (false);
+    }
+
+    if (techno->TarCom == target || techno->SuspendedTarCom == target || techno->ArchiveTarget == target) {
+        return (true);
+    }
+    if (techno->In_Radio_Contact() && techno->Contact_With_Whom()->As_Target() == target) {
+        return (true);
+    }
+
+    if (techno->Is_Foot()) {
+        FootClass const* foot = (FootClass const*)techno;
+        if (foot->NavCom == target || foot->SuspendedNavCom == target) {
+            return (true);
+        }
+        for (int index = 0; index < ARRAY_SIZE(foot->NavQueue); index++) {
+            if (foot->NavQueue[index] == target) {
+                return (true);
+            }
+        }
+    }
+
+    if (techno->What_Am_I() == RTTI_BUILDING) {
+        BuildingClass const* building = (BuildingClass const*)techno;
+        if (building->WhomToRepay == target || building->AnimToTrack == target) {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+/*
+**	Referrers are detached in the order the heaps used to be swept in, and by ID within
+**	each heap. A referrer's Detach only changes the referrer itself, and the target when
+**	they were in radio contact, so the order within a heap cannot change the outcome.
+*/
+static int Referrer_Rank(TARGET referrer)
+{
+    switch (Target_Kind(referrer)) {
+    case RTTI_UNIT:
+        return (0);
+    case RTTI_VESSEL:
+        return (1);
+    case RTTI_AIRCRAFT:
+        return (2);
+    case RTTI_BUILDING:
+        return (3);
+    default:
+        return (4);
+    }
+}
+
+static bool Referrer_Before(TARGET left, TARGET right)
+{
+    int left_rank = Referrer_Rank(left);
+    int right_rank = Referrer_Rank(right);
+    if (left_rank != right_rank) {
+        return (left_rank < right_rank);
+    }
+    return (Target_Value(left) < Target_Value(right));
+}
+
+/***********************************************************************************************
+ * Add_Referrer -- Notes that an object may now be holding a target.                           *
+ *                                                                                             *
+ *    Every write of an object or animation into a field that a game object's Detach function  *
+ *    checks must be reported here, or the object won't be detached when the target goes.      *
+ *    Targets of other kinds (cells, triggers and so on) are ignored, since the objects are    *
+ *    still swept for those.                                                                   *
+ *                                                                                             *
+ * INPUT:   target   -- The target that the referrer now holds.                                *
+ *                                                                                             *
+ *          referrer -- The game object holding it.                                            *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void Add_Referrer(TARGET target, TARGET referrer)
+{
+    if (Is_Target_Object(target) || Is_Target_Animation(target)) {
+        _Referrers.Add(Target_Kind(target), Target_Value(target), target, referrer, Holds_Target);
+    }
+}
+
+/***********************************************************************************************
+ * Clear_Referrers -- Forgets every object noted as holding a target.                          *
+ *                                                                                             *
+ *    This is called when the scenario is cleared and all the game objects go with it.         *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void Clear_Referrers(void)
+{
+    _Referrers.Clear();
+}
+
+/*
+**	Notes every object or animation the techno holds.
+*/
+static void Add_Held(TechnoClass const* techno)
+{
+    TARGET referrer = techno->As_Target();
+
+    Add_Referrer(techno->TarCom, referrer);
+    Add_Referrer(techno->SuspendedTarCom, referrer);
+    Add_Referrer(techno->ArchiveTarget, referrer);
+    if (techno->In_Radio_Contact()) {
+        Add_Referrer(techno->Contact_With_Whom()->As_Target(), referrer);
+    }
+
+    if (techno->Is_Foot()) {
+        FootClass const* foot = (FootClass const*)techno;
+        Add_Referrer(foot->NavCom, referrer);
+        Add_Referrer(foot->SuspendedNavCom, referrer);
+        for (int index = 0; index < ARRAY_SIZE(foot->NavQueue); index++) {
+            Add_Referrer(foot->NavQueue[index], referrer);
+        }
+    }
+
+    if (techno->What_Am_I() == RTTI_BUILDING) {
+        BuildingClass const* building = (BuildingClass const*)techno;
+        Add_Referrer(building->WhomToRepay, referrer);
+        Add_Referrer(building->AnimToTrack, referrer);
+    }
+}
+
+/***********************************************************************************************
+ * Rebuild_Referrers -- Notes every target held by every object from scratch.                  *
+ *                                                                                             *
+ *    The fields of a loaded game are read in without passing through Add_Referrer, so the     *
+ *    lists are made again from the objects once they are all loaded.                          *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void Rebuild_Referrers(void)
+{
+    int index;
+
+    _Referrers.Clear();
+    for (index = 0; index < Units.Count(); index++) {
+        Add_Held(Units.Ptr(index));
+    }
+    for (index = 0; index < Vessels.Count(); index++) {
+        Add_Held(Vessels.Ptr(index));
+    }
+    for (index = 0; index < Aircraft.Count(); index++) {
+        Add_Held(Aircraft.Ptr(index));
+    }
+    for (index = 0; index < Buildings.Count(); index++) {
+        Add_Held(Buildings.Ptr(index));
+    }
+    for (index = 0; index < Infantry.Count(); index++) {
+        Add_Held(Infantry.Ptr(index));
+    }
+}
+
+#ifndef NDEBUG
+/*
+**	Sweeps every object the way the detach used to, and checks that any object holding
+**	the target is listed as a referrer of it.
+*/
+static void Check_Referrers(TARGET target)
+{
+    int kind = Target_Kind(target);
+    unsigned id = Target_Value(target);
+    int index;
+
+    for (index = 0; index < Units.Count(); index++) {
+        TARGET referrer = Units.Ptr(index)->As_Target();
+        assert(!Holds_Target(referrer, target) || _Referrers.Is_Listed(kind, id, referrer));
+    }
+    for (index = 0; index < Vessels.Count(); index++) {
+        TARGET referrer = Vessels.Ptr(index)->As_Target();
+        assert(!Holds_Target(referrer, target) || _Referrers.Is_Listed(kind, id, referrer));
+    }
+    for (index = 0; index < Aircraft.Count(); index++) {
+        TARGET referrer = Aircraft.Ptr(index)->As_Target();
+        assert(!Holds_Target(referrer, target) || _Referrers.Is_Listed(kind, id, referrer));
+    }
+    for (index = 0; index < Buildings.Count(); index++) {
+        TARGET referrer = Buildings.Ptr(index)->As_Target();
+        assert(!Holds_Target(referrer, target) || _Referrers.Is_Listed(kind, id, referrer));
+    }
+    for (index = 0; index < Infantry.Count(); index++) {
+        TARGET referrer = Infantry.Ptr(index)->As_Target();
+        assert(!Holds_Target(referrer, target) || _Referrers.Is_Listed(kind, id, referrer));
+    }
+}
+#endif
 
 /***********************************************************************************************
  * Detach_This_From_All -- Detaches this object from all others.                               *
@@ -51,7 +270,9 @@
  *                                                                                             *
  * OUTPUT:  none                                                                               *
  *                                                                                             *
- * WARNINGS:   none                                                                            *
+ * WARNINGS:   The lists whose Detach could not act on a target of this kind are skipped.      *
+ *             Any new target held by those classes must be reflected in the tests here,       *
+ *             and any new field holding an object or animation must report to Add_Referrer.   *
  *                                                                                             *
  * HISTORY:                                                                                    *
  *   05/08/1995 JLB : Created.                                                                 *
@@ -67,29 +288,97 @@ void Detach_This_From_All(TARGET target, bool all)
         for (index = 0; index < Teams.Count(); index++) {
             Teams.Ptr(index)->Detach(target, all);
         }
-        for (index = 0; index < TeamTypes.Count(); index++) {
-            TeamTypes.Ptr(index)->Detach(target, all);
-        }
-        for (index = 0; index < Units.Count(); index++) {
-            Units.Ptr(index)->Detach(target, all);
-        }
-        for (index = 0; index < Vessels.Count(); index++) {
-            Vessels.Ptr(index)->Detach(target, all);
+
+        /*
+        **	Team types only refer to trigger types, so the sweep over them is only
+        **	needed when a trigger type is going away.
+        */
+        if (Is_Target_TriggerType(target)) {
+            for (index = 0; index < TeamTypes.Count(); index++) {
+                TeamTypes.Ptr(index)->Detach(target, all);
+            }
         }
-        for (index = 0; index < Aircraft.Count(); index++) {
-            Aircraft.Ptr(index)->Detach(target, all);
+
+        /*
+        **	Game objects hold their attached trigger and the cells and objects they target,
+        **	move to or are in radio contact with. None of them ever refer to teams, team or
+        **	trigger types or bullets. Objects and animations are only held in fields that
+        **	report to Add_Referrer, so only their listed referrers are visited.
+        */
+        bool techno = !Is_Target_Team(target) && !Is_Target_TeamType(target) && !Is_Target_TriggerType(target)
+                      && !Is_Target_Bullet(target);
+        bool listed = Is_Target_Object(target) || Is_Target_Animation(target);
+
+        std::vector<TARGET> referrers;
+        if (listed) {
+#ifndef NDEBUG
+            Check_Referrers(target);
+#endif
+            std::vector<TARGET> const* list = _Referrers.Get(Target_Kind(target), Target_Value(target));
+            if (list != NULL) {
+                referrers = *list;
+                std::sort(referrers.begin(), referrers.end(), Referrer_Before);
+            }
         }
-        for (index = 0; index < Buildings.Count(); index++) {
-            Buildings.Ptr(index)->Detach(target, all);
+
+        unsigned next = 0;
+        if (listed) {
+            for (; next < referrers.size() && Target_Kind(referrers[next]) != RTTI_INFANTRY; next++) {
+                TechnoClass* referrer = As_Techno(referrers[next]);
+                if (referrer != NULL) {
+                    referrer->Detach(target, all);
+                }
+            }
+        } else if (techno) {
+            for (index = 0; index < Units.Count(); index++) {
+                Units.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Vessels.Count(); index++) {
+                Vessels.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Aircraft.Count(); index++) {
+                Aircraft.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Buildings.Count(); index++) {
+                Buildings.Ptr(index)->Detach(target, all);
+            }
         }
-        for (index = 0; index < Bullets.Count(); index++) {
-            Bullets.Ptr(index)->Detach(target, all);
+
+        /*
+        **	A bullet only lets go of its target when the target is removed for good;
+        **	otherwise it can only be holding the object as the techno to pay back.
+        */
+        if (all || Is_Target_Object(target)) {
+            for (index = 0; index < Bullets.Count(); index++) {
+                Bullets.Ptr(index)->Detach(target, all);
+            }
         }
-        for (index = 0; index < Infantry.Count(); index++) {
-            Infantry.Ptr(index)->Detach(target, all);
+        if (listed) {
+            for (; next < referrers.size(); next++) {
+                TechnoClass* referrer = As_Techno(referrers[next]);
+                if (referrer != NULL) {
+                    referrer->Detach(target, all);
+                }
+            }
+
+            /*
+            **	Referrers that let go are dropped. Any that are still holding the target,
+            **	in a field their Detach leaves alone, stay listed in case the ID is reused.
+            */
+            _Referrers.Prune(Target_Kind(target), Target_Value(target), target, Holds_Target);
+        } else if (techno) {
+            for (index = 0; index < Infantry.Count(); index++) {
+                Infantry.Ptr(index)->Detach(target, all);
+            }
         }
-        for (index = 0; index < Anims.Count(); index++) {
-            Anims.Ptr(index)->Detach(target, all);
+
+        /*
+        **	Animations stay attached to objects that are only cloaking.
+        */
+        if (all) {
+            for (index = 0; index < Anims.Count(); index++) {
+                Anims.Ptr(index)->Detach(target, all);
+            }
         }
 
         Map.Detach(target, all);
@@ -114,11 +403,20 @@ void Detach_This_From_All(TARGET target, bool all)
             }
         }
 
-        for (index = 0; index < Triggers.Count(); index++) {
-            Triggers.Ptr(index)->Detach(target, all);
+
+        /*
+        **	Triggers hold nothing but their type, and trigger type actions only
+        **	refer to team types and other trigger types.
+        */
+        if (Is_Target_TriggerType(target)) {
+            for (index = 0; index < Triggers.Count(); index++) {
+                Triggers.Ptr(index)->Detach(target, all);
+            }
         }
-        for (index = 0; index < TriggerTypes.Count(); index++) {
-            TriggerTypes.Ptr(index)->Detach(target, all);
+        if (Is_Target_TriggerType(target) || Is_Target_TeamType(target)) {
+            for (index = 0; index < TriggerTypes.Count(); index++) {
+                TriggerTypes.Ptr(index)->Detach(target, all);
+            }
         }
     }
 }
@@ -37,6 +37,7 @@
  *   TriggerClass::Detach -- Detach specified target from this trigger.                        *
  *   TriggerClass::Draw_It -- Draws this trigger as if it were part of a list box.             *
  *   TriggerClass::Init -- clears triggers for new scenario                                    *
+ *   TriggerClass::Is_Quiet -- Is it certain that springing the trigger would do nothing?      *
  *   TriggerClass::Spring -- Spring the trigger (possibly).                                    *
  *   TriggerClass::TriggerClass -- constructor                                                 *
  *   TriggerClass::operator delete -- Returns a trigger to the special memory pool.            *
@@ -227,6 +228,15 @@ bool TriggerClass::Spring(TEventType event, ObjectClass* obj, CELL cell, bool fo
 {
     assert(Triggers.ID(this) == ID);
 
+    /*
+    **	Most calls find an unexpired timer or a global flag in the wrong state. Those
+    **	are recognised here without going through the full event evaluation.
+    */
+    if (!forced && Is_Quiet(event)) {
+        return (false);
+    }
+    Telemetry.Add(TELEMETRY_SPRINGS);
+
     bool e1 = Class->Event1(Event1, event, Class->House, obj, forced);
     bool e2 = false;
     bool execute = false;
@@ -364,6 +374,27 @@ bool TriggerClass::Spring(TEventType event, ObjectClass* obj, CELL cell, bool fo
     return (false);
 }
 
+/***********************************************************************************************
+ * TriggerClass::Is_Quiet -- Is it certain that springing the trigger would do nothing?        *
+ *                                                                                             *
+ *    Checks whether every event that Spring would evaluate for this trigger is quiet, that    *
+ *    is, certain to fail without tripping. If so, springing the trigger with this event       *
+ *    would return false and change nothing.                                                   *
+ *                                                                                             *
+ * INPUT:   event    -- The event that Spring would be called with.                            *
+ *                                                                                             *
+ * OUTPUT:  bool; Can the trigger not be sprung by this event?                                 *
+ *                                                                                             *
+ * WARNINGS:   Forced springs ignore the events, so this doesn't apply to them.                *
+ *=============================================================================================*/
+bool TriggerClass::Is_Quiet(TEventType event) const
+{
+    if (!Class->Event1.Is_Quiet(Event1, event)) {
+        return (false);
+    }
+    return (Class->EventControl == MULTI_ONLY || Class->Event2.Is_Quiet(Event2, event));
+}
+
 /***********************************************************************************************
  * TriggerClass::operator new -- 'new' operator                                                *
  *                                                                                             *
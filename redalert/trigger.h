@@ -68,6 +68,7 @@ public:
     **	Processing routines
     */
     bool Spring(TEventType event = TEVENT_ANY, ObjectClass* object = 0, CELL cell = 0, bool forced = false);
+    bool Is_Quiet(TEventType event) const;
     void Detach(TARGET target, bool all = true);
 
     /*
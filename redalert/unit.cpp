@@ -887,6 +887,7 @@ RadioMessageType UnitClass::Receive_Message(RadioClass* from, RadioMessageType m
                 // Slight hack; set a target so the harvest mission knows to skip to finding home state
                 Assign_Mission(MISSION_HARVEST);
                 TarCom = As_Target();
+                Add_Referrer(TarCom, As_Target());
                 return (RADIO_ROGER);
             }
         }
@@ -2318,6 +2319,19 @@ bool UnitClass::Goto_Tiberium(int rad)
                 CELL bestcell = 0;
                 int tiberium = 0;
                 int besttiberium = 0;
+
+                /*
+                **	Rings that pass only through map blocks without any Tiberium
+                **	can't turn up a cell, so the checks are skipped for them. The
+                **	corners are still shuffled so the random sequence is unchanged.
+                */
+                int cx = Cell_X(center);
+                int cy = Cell_Y(center);
+                bool ring = CellClass::Is_Tiberium_In(cx - radius, cy - radius, cx + radius, cy - radius)
+                            || CellClass::Is_Tiberium_In(cx - radius, cy + radius, cx + radius, cy + radius)
+                            || CellClass::Is_Tiberium_In(cx - radius, cy - radius, cx - radius, cy + radius)
+                            || CellClass::Is_Tiberium_In(cx + radius, cy - radius, cx + radius, cy + radius);
+
                 for (int x = -radius; x <= radius; x++) {
 
                     /*
@@ -2332,6 +2346,10 @@ bool UnitClass::Goto_Tiberium(int rad)
                         memcpy(&corners[i], corner, sizeof(corner));
                     }
 
+                    if (!ring) {
+                        continue;
+                    }
+
                     cell = center;
                     tiberium = Tiberium_Check(cell, corners[0][0], corners[0][1]);
                     if (tiberium > besttiberium) {
@@ -4718,6 +4736,7 @@ void UnitClass::Assign_Destination(TARGET target)
                 if (b->In_Radio_Contact()) {
                     // TCTCTC -- call for an update from the transport to get a good rendezvous position.
                     ArchiveTarget = target;
+                    Add_Referrer(ArchiveTarget, As_Target());
 
                     /*
                     **	HACK ALERT: The repair bay is counting on the assignment of the NavCom by this routine.
@@ -4731,10 +4750,12 @@ void UnitClass::Assign_Destination(TARGET target)
                         Transmit_Message(RADIO_OVER_OUT);
                         if (*b == STRUCT_REPAIR) {
                             ArchiveTarget = target;
+                            Add_Referrer(ArchiveTarget, As_Target());
                         }
                     }
                     if (*b != STRUCT_REPAIR) {
                         ArchiveTarget = target;
+                        Add_Referrer(ArchiveTarget, As_Target());
                         target = TARGET_NONE;
                     }
                 }
@@ -4750,6 +4771,7 @@ void UnitClass::Assign_Destination(TARGET target)
                         // TCTCTC -- call for an update from the transport to get a good rendezvous position.
 
                         ArchiveTarget = target;
+                        Add_Referrer(ArchiveTarget, As_Target());
                     } else {
                         if (Transmit_Message(RADIO_HELLO, techno) == RADIO_ROGER) {
                             if (Transmit_Message(RADIO_DOCKING) != RADIO_ROGER) {
@@ -4777,6 +4799,7 @@ void UnitClass::Assign_Destination(TARGET target)
         if (b->In_Radio_Contact() && (b->Contact_With_Whom() != this)) {
             //			if (target != NULL) {
             ArchiveTarget = target;
+            Add_Referrer(ArchiveTarget, As_Target());
             //			}
             //			target = TARGET_NONE;
         } else {
@@ -5350,6 +5373,7 @@ int UnitClass::Mission_Guard_Area(void)
 
                 infantry->Assign_Mission(MISSION_ENTER);
                 infantry->ArchiveTarget = As_Target();
+                Add_Referrer(infantry->ArchiveTarget, infantry->As_Target());
                 needed--;
             }
         }
@@ -63,9 +63,10 @@ static VersionProtocolType VersionProtocol[] = {
     {0x00001000, COMM_PROTOCOL_SINGLE_NO_COMP}, // (obsolete)
     {0x00002000, COMM_PROTOCOL_SINGLE_E_COMP},  // (obsolete)
     {0x00010000, COMM_PROTOCOL_MULTI_E_COMP},
+    {0x00030004, COMM_PROTOCOL_MULTI_DELTA_COMP},
 };
 
-#define GAME_VERSION 0x30003
+#define GAME_VERSION 0x30004
 VersionClass VerNum;
 
 /***************************************************************************
@@ -67,8 +67,9 @@ typedef enum CommProtocolEnum
     COMM_PROTOCOL_SINGLE_NO_COMP = 0, // single frame with no compression
     COMM_PROTOCOL_SINGLE_E_COMP,      // single frame with event compression
     COMM_PROTOCOL_MULTI_E_COMP,       // multiple frame with event compression
+    COMM_PROTOCOL_MULTI_DELTA_COMP,   // as above, with delta coded MegaMission 'Whom's
     COMM_PROTOCOL_COUNT,
-    DEFAULT_COMM_PROTOCOL = COMM_PROTOCOL_MULTI_E_COMP
+    DEFAULT_COMM_PROTOCOL = COMM_PROTOCOL_MULTI_DELTA_COMP
 } CommProtocolType;
 
 typedef struct
@@ -0,0 +1,111 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef WHOMDELTA_H
+#define WHOMDELTA_H
+
+#include <stddef.h>
+#include <string.h>
+
+/*
+**	MegaMission runs in a compressed packet: the rep count byte holds the number of units
+**	in the run; the high bit flags that the 'Whom' fields after the first are stored as
+**	variable-length deltas from the previous unit rather than verbatim. The flag is only
+**	sent, and only looked for, from COMM_PROTOCOL_MULTI_DELTA_COMP on.
+*/
+#define MEGAMISSION_DELTA   0x80
+#define MEGAMISSION_RUN_MAX 0x7F
+
+/*
+**	Units given the same order are usually of the same type, and were created close
+**	together, so consecutive 'Whom' values in a run differ by only a little. The difference
+**	is zigzag-encoded and stored 7 bits per byte, with the high bit set on every byte but
+**	the last; a typical delta fits in a single byte. The values are TARGETs. Pass a NULL
+**	buffer to just work out the size. Returns the number of bytes used.
+*/
+inline int Encode_Whom_Delta(unsigned char* buf, long prev, long whom)
+{
+    unsigned long delta = (unsigned long)whom - (unsigned long)prev;
+    unsigned long value = (delta << 1) ^ (0UL - (delta >> (sizeof(delta) * 8 - 1)));
+    int size = 0;
+
+    do {
+        unsigned char byte = value & 0x7F;
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        if (buf != NULL) {
+            buf[size] = byte;
+        }
+        size++;
+    } while (value);
+
+    return (size);
+}
+
+/*
+**	Reads back a delta stored by Encode_Whom_Delta. Returns the number of bytes used, or
+**	zero if the delta runs past the end of the buffer or is too long to be valid.
+*/
+inline int Decode_Whom_Delta(unsigned char const* buf, int bufsize, long prev, long& whom)
+{
+    unsigned long value = 0;
+    int size = 0;
+    int shift = 0;
+
+    for (;;) {
+        if (size >= bufsize || shift >= (int)(sizeof(value) * 8)) {
+            return (0);
+        }
+        unsigned char byte = buf[size++];
+        value |= (unsigned long)(byte & 0x7F) << shift;
+        shift += 7;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+
+    unsigned long delta = (value >> 1) ^ (0UL - (value & 1));
+    whom = (long)((unsigned long)prev + delta);
+
+    return (size);
+}
+
+/*
+**	Stores or reads one 'Whom' after the first in a run, as a delta when the run is flagged
+**	with MEGAMISSION_DELTA and verbatim otherwise. They return the number of bytes used,
+**	and reading returns zero if the buffer is too short.
+*/
+inline int Encode_Whom(unsigned char* buf, long prev, long whom, bool delta)
+{
+    if (delta) {
+        return (Encode_Whom_Delta(buf, prev, whom));
+    }
+    if (buf != NULL) {
+        memcpy(buf, &whom, sizeof(whom));
+    }
+    return (sizeof(whom));
+}
+
+inline int Decode_Whom(unsigned char const* buf, int bufsize, long prev, long& whom, bool delta)
+{
+    if (delta) {
+        return (Decode_Whom_Delta(buf, bufsize, prev, whom));
+    }
+    if (bufsize < (int)sizeof(whom)) {
+        return (0);
+    }
+    memcpy(&whom, buf, sizeof(whom));
+    return (sizeof(whom));
+}
+
+#endif
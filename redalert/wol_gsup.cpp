@@ -3419,7 +3419,7 @@ void WOL_GameSetupDialog::TriggerGameStart(char* szGoMessage)
         }
     }
 
-    Session.CommProtocol = COMM_PROTOCOL_MULTI_E_COMP;
+    Session.CommProtocol = DEFAULT_COMM_PROTOCOL;
     Ipx.Set_Timing(30, (unsigned long)-1, 600);
 
     pWO->bEnableNewAftermathUnits = bAftermathUnits;
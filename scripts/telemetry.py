@@ -0,0 +1,83 @@
+'''
+This program is is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+This program is is distributed in the hope that it will be useful, but with permitted additional restrictions
+under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+distributed with this program. You should have received a copy of the
+GNU General Public License along with permitted additional restrictions
+with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+'''
+import argparse
+import csv
+import json
+import math
+import sys
+
+def read_frames(path):
+    frames = []
+    with open(path) as handle:
+        first = handle.readline()
+        handle.seek(0)
+        if first.startswith('{'):
+            for line in handle:
+                line = line.strip()
+                if line:
+                    frames.append(json.loads(line))
+        else:
+            for row in csv.DictReader(handle):
+                frames.append({key: int(value) for key, value in row.items()})
+    return frames
+
+def percentile(values, fraction):
+    if not values:
+        return 0
+    index = int(math.ceil(fraction * len(values))) - 1
+    return values[max(0, min(index, len(values) - 1))]
+
+def summarise(frames, skip):
+    frames = frames[skip:]
+    if not frames:
+        return []
+
+    columns = [key for key in frames[0].keys() if key != 'frame']
+    rows = []
+    for column in columns:
+        values = sorted(frame.get(column, 0) for frame in frames)
+        rows.append((column,
+                     sum(values) / float(len(values)),
+                     percentile(values, 0.50),
+                     percentile(values, 0.90),
+                     percentile(values, 0.99),
+                     values[-1]))
+    return rows
+
+def main():
+    parser = argparse.ArgumentParser(description='Summarise a telemetry file written by the game.')
+    parser.add_argument('file', help='CSV or JSON lines telemetry file')
+    parser.add_argument('--skip', type=int, default=0, help='frames to leave out at the start, such as loading')
+    parser.add_argument('--sort', choices=['name', 'mean', 'p50', 'p90', 'p99', 'max'], default='name',
+                        help='column to sort the summary by, largest first')
+    parser.add_argument('--match', default='', help='only show fields whose name contains this')
+    args = parser.parse_args()
+
+    frames = read_frames(args.file)
+    rows = [row for row in summarise(frames, args.skip) if args.match in row[0]]
+    if not rows:
+        sys.stderr.write('No frames to summarise.\n')
+        return 1
+
+    if args.sort != 'name':
+        key = ['mean', 'p50', 'p90', 'p99', 'max'].index(args.sort) + 1
+        rows.sort(key=lambda row: row[key], reverse=True)
+
+    width = max(len(row[0]) for row in rows)
+    print('%d frames' % (len(frames) - args.skip))
+    print('%-*s %12s %10s %10s %10s %10s' % (width, 'field', 'mean', 'p50', 'p90', 'p99', 'max'))
+    for row in rows:
+        print('%-*s %12.1f %10d %10d %10d %10d' % (width, row[0], row[1], row[2], row[3], row[4], row[5]))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
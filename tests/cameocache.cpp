@@ -0,0 +1,125 @@
+#include "redalert/cameocache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define COLUMNS 2
+#define SLOTS   5
+#define VISIBLE 4
+
+static int Page[2];
+
+static void Make_States(CameoStateType* state, int column)
+{
+    memset(state, 0, sizeof(CameoStateType) * SLOTS);
+    for (int i = 0; i < SLOTS; i++) {
+        state[i].ShapeNum = column * 10 + i;
+        state[i].X = column * 80;
+        state[i].Y = i * 48;
+    }
+}
+
+static int Count(bool const* draw, int count)
+{
+    int drawn = 0;
+    for (int i = 0; i < count; i++) {
+        drawn += draw[i] ? 1 : 0;
+    }
+    return drawn;
+}
+
+/*
+**	Both strips draw in turn onto one page, then the page flips and each must draw every
+**	slot again on the new one, even though the first to draw has already seen the flip.
+*/
+int test_flip(void)
+{
+    CameoCacheClass<SLOTS> cache[COLUMNS];
+    CameoStateType state[COLUMNS][SLOTS];
+    bool draw[SLOTS];
+
+    for (int column = 0; column < COLUMNS; column++) {
+        Make_States(state[column], column);
+    }
+
+    for (int frame = 0; frame < 6; frame++) {
+        void const* page = &Page[frame / 2 % 2];
+        bool flipped = frame % 2 == 0;
+
+        for (int column = 0; column < COLUMNS; column++) {
+            bool all = cache[column].Update(state[column], VISIBLE, page, false, false, draw);
+            int expected = flipped ? VISIBLE : 0;
+            if (all != flipped || Count(draw, VISIBLE) != expected) {
+                printf("flip: column %d drew %d slots on frame %d\n", column, Count(draw, VISIBLE), frame);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+**	On an unchanged page only the slot that changed is drawn, unless the slots share a
+**	background, the strip is forced, or the slot has been forgotten.
+*/
+int test_changes(void)
+{
+    CameoCacheClass<SLOTS> cache;
+    CameoStateType state[SLOTS];
+    bool draw[SLOTS];
+
+    Make_States(state, 0);
+    cache.Update(state, VISIBLE, &Page[0], false, false, draw);
+
+    state[2].Stage++;
+    if (cache.Update(state, VISIBLE, &Page[0], false, false, draw) || Count(draw, VISIBLE) != 1 || !draw[2]) {
+        printf("changes: one changed slot not drawn alone\n");
+        return 1;
+    }
+
+    state[1].IsDark = true;
+    if (!cache.Update(state, VISIBLE, &Page[0], false, true, draw) || Count(draw, VISIBLE) != VISIBLE) {
+        printf("changes: shared background not drawn in full\n");
+        return 1;
+    }
+
+    if (cache.Update(state, VISIBLE, &Page[0], false, true, draw) || Count(draw, VISIBLE) != 0) {
+        printf("changes: unchanged slots drawn\n");
+        return 1;
+    }
+
+    if (!cache.Update(state, VISIBLE, &Page[0], true, false, draw) || Count(draw, VISIBLE) != VISIBLE) {
+        printf("changes: forced strip not drawn in full\n");
+        return 1;
+    }
+
+    /*
+    **	The slot scrolled in from below is drawn while scrolling, off the page afterwards,
+    **	so it is drawn again the next time it shows.
+    */
+    cache.Update(state, SLOTS, &Page[0], true, false, draw);
+    cache.Update(state, VISIBLE, &Page[0], false, false, draw);
+    if (cache.Update(state, SLOTS, &Page[0], false, false, draw) || Count(draw, SLOTS) != 1 || !draw[VISIBLE]) {
+        printf("changes: scrolled in slot not drawn again\n");
+        return 1;
+    }
+
+    cache.Forget();
+    if (cache.Update(state, VISIBLE, &Page[0], false, false, draw) || Count(draw, VISIBLE) != VISIBLE) {
+        printf("changes: forgotten slots not drawn\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_flip();
+    ret |= test_changes();
+
+    return ret;
+}
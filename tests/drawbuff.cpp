@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
+#include <chrono>
 #include <iostream>
 
 // Globals needed to compile GraphicBufferClass.
@@ -103,6 +104,168 @@ int test_frombuff()
     return ret;
 }
 
+/*
+** Builds a Red Alert style tileset of 24x24 icons. Icon 0 is opaque, icon 1 has
+** transparent pixels. Icon data is a simple pattern with plenty of zeros.
+*/
+enum
+{
+    STAMP_ICONS = 2,
+    STAMP_SIZE = 24,
+    STAMP_HEADER = 0x28
+};
+
+static uint8_t StampSet[STAMP_HEADER + STAMP_ICONS * STAMP_SIZE * STAMP_SIZE + STAMP_ICONS * 2];
+
+static void Build_Stamp_Set()
+{
+    uint8_t* p = StampSet;
+    int icons = STAMP_HEADER;
+    int trans = icons + STAMP_ICONS * STAMP_SIZE * STAMP_SIZE;
+    int map = trans + STAMP_ICONS;
+    int16_t header16[] = {STAMP_SIZE, STAMP_SIZE, STAMP_ICONS, 0, 1, 1};
+    int32_t header32[] = {int32_t(sizeof(StampSet)), icons, 0, 0, trans, 0, map};
+
+    memset(StampSet, 0, sizeof(StampSet));
+    memcpy(p, header16, sizeof(header16));
+    memcpy(p + sizeof(header16), header32, sizeof(header32));
+
+    for (int i = 0; i < STAMP_ICONS * STAMP_SIZE * STAMP_SIZE; ++i) {
+        p[icons + i] = (i * 37 + (i >> 5)) % 7 == 0 ? 0 : uint8_t(i * 13 + 5);
+    }
+    p[trans + 0] = 0;
+    p[trans + 1] = 1;
+    p[map + 0] = 0;
+    p[map + 1] = 1;
+}
+
+static void Reference_Stamp(
+    uint8_t* buff, int pitch, int icon, int x, int y, const uint8_t* remap, int left, int top, int width, int height)
+{
+    const uint8_t* src = StampSet + STAMP_HEADER + icon * STAMP_SIZE * STAMP_SIZE;
+    bool trans = remap != nullptr || StampSet[STAMP_HEADER + STAMP_ICONS * STAMP_SIZE * STAMP_SIZE + icon] != 0;
+
+    for (int i = 0; i < STAMP_SIZE; ++i) {
+        for (int j = 0; j < STAMP_SIZE; ++j) {
+            int dx = left + x + j;
+            int dy = top + y + i;
+
+            if (dx < left || dx >= left + width || dy < top || dy >= top + height) {
+                continue;
+            }
+
+            uint8_t pixel = src[i * STAMP_SIZE + j];
+            if (remap != nullptr) {
+                pixel = remap[pixel];
+            }
+
+            if (pixel != 0 || !trans) {
+                buff[dy * pitch + dx] = pixel;
+            }
+        }
+    }
+}
+
+int test_stamp()
+{
+    int ret = 0;
+    const int w = 80;
+    const int h = 60;
+    GraphicBufferClass gb(w, h);
+    uint8_t expected[w * h];
+    uint8_t remap[256];
+
+    Build_Stamp_Set();
+
+    for (int i = 0; i < 256; ++i) {
+        remap[i] = i % 5 == 0 ? 0 : uint8_t(255 - i);
+    }
+
+    const int windows[][4] = {{0, 0, w, h}, {5, 3, 50, 40}, {17, 11, 13, 9}};
+
+    if (!gb.Lock()) {
+        fprintf(stderr, "gb.Lock() failed.\n");
+        return 1;
+    }
+
+    uint8_t* buff = static_cast<uint8_t*>(gb.Get_Buffer());
+
+    for (auto& window : windows) {
+        memcpy(WindowList[0], window, sizeof(window));
+
+        for (int icon = 0; icon < STAMP_ICONS; ++icon) {
+            for (int use_remap = 0; use_remap < 2; ++use_remap) {
+                for (int y = -30; y < window[3] + 6; y += 7) {
+                    for (int x = -30; x < window[2] + 6; x += 5) {
+                        for (int i = 0; i < w * h; ++i) {
+                            buff[i] = uint8_t(i * 7 + x + y);
+                        }
+                        memcpy(expected, buff, sizeof(expected));
+
+                        const uint8_t* table = use_remap ? remap : nullptr;
+                        gb.Draw_Stamp(StampSet, icon, x, y, table, 0);
+                        Reference_Stamp(expected, w, icon, x, y, table, window[0], window[1], window[2], window[3]);
+
+                        if (memcmp(buff, expected, sizeof(expected)) != 0) {
+                            fprintf(stderr,
+                                    "Draw_Stamp(icon %d, %d, %d, remap %d) in window %d,%d %dx%d did not match.\n",
+                                    icon,
+                                    x,
+                                    y,
+                                    use_remap,
+                                    window[0],
+                                    window[1],
+                                    window[2],
+                                    window[3]);
+                            ret = 1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    gb.Unlock();
+    return ret;
+}
+
+/*
+** Reports how long it takes to cover a 1920x1080 screen with icons, it doesn't
+** fail on any time, it is there to compare builds.
+*/
+void bench_stamp()
+{
+    const int w = 1920;
+    const int h = 1080;
+    const int frames = 50;
+    GraphicBufferClass gb(w, h);
+
+    Build_Stamp_Set();
+    int window[4] = {0, 0, w, h};
+    memcpy(WindowList[0], window, sizeof(window));
+
+    if (!gb.Lock()) {
+        return;
+    }
+
+    for (int icon = 0; icon < STAMP_ICONS; ++icon) {
+        auto start = std::chrono::steady_clock::now();
+
+        for (int frame = 0; frame < frames; ++frame) {
+            for (int y = 0; y < h; y += STAMP_SIZE) {
+                for (int x = 0; x < w; x += STAMP_SIZE) {
+                    gb.Draw_Stamp(StampSet, icon, x, y, nullptr, 0);
+                }
+            }
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("%s stamps: %.3f ms per %dx%d screen\n", icon ? "transparent" : "opaque", ms / frames, w, h);
+    }
+
+    gb.Unlock();
+}
+
 int main(int argc, char** argv)
 {
     int ret = 0;
@@ -110,6 +273,9 @@ int main(int argc, char** argv)
     ret |= test_clear();
     ret |= test_fill();
     ret |= test_frombuff();
+    ret |= test_stamp();
+
+    bench_stamp();
 
     return ret;
 }
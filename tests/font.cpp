@@ -0,0 +1,186 @@
+#include "common/font.h"
+#include "common/gbuffer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Globals needed to compile GraphicBufferClass.
+bool GameInFocus;
+int ScreenWidth;
+int WindowList[9][9];
+extern "C" char* _ShapeBuffer = 0;
+
+int Open_File(char const*, int)
+{
+    return 0;
+}
+
+void Close_File(int)
+{
+}
+
+long Read_File(int, void*, unsigned long)
+{
+    return 0;
+}
+
+#define CHAR_COUNT   8
+#define FONT_HEIGHT  9
+#define BUFFER_SIZE  32
+
+/*
+**	A font made up in memory in the layout Load_Font expects: the header, then a data
+**	offset, a width and a top line/line count pair for each character, then the 4 bit
+**	pixel data. Character 2 has no lines at all, and the widths are mostly odd so
+**	the last nibble of each row is left over.
+*/
+static unsigned char Font[2048];
+
+static const unsigned char Widths[CHAR_COUNT] = {3, 5, 1, 4, 7, 2, 6, 5};
+static const unsigned char Tops[CHAR_COUNT] = {2, 0, 3, 1, 0, 8, 2, 4};
+static const unsigned char Lines[CHAR_COUNT] = {4, 9, 0, 6, 5, 1, 7, 3};
+
+static unsigned short Get_Short(int offset)
+{
+    return (unsigned short)(Font[offset] | (Font[offset + 1] << 8));
+}
+
+static void Put_Short(int offset, unsigned short value)
+{
+    Font[offset] = value & 0xFF;
+    Font[offset + 1] = value >> 8;
+}
+
+static void Make_Font(void)
+{
+    int offsets = 20;
+    int widths = offsets + CHAR_COUNT * 2;
+    int heights = widths + CHAR_COUNT;
+    int data = heights + CHAR_COUNT * 2;
+
+    memset(Font, 0, sizeof(Font));
+    Put_Short(4, 16);
+    Put_Short(6, (unsigned short)offsets);
+    Put_Short(8, (unsigned short)widths);
+    Put_Short(10, (unsigned short)data);
+    Put_Short(12, (unsigned short)heights);
+    Font[17] = CHAR_COUNT - 1;
+    Font[18] = FONT_HEIGHT;
+    Font[19] = 7;
+
+    unsigned seed = 12345;
+    for (int c = 0; c < CHAR_COUNT; c++) {
+        Put_Short(offsets + c * 2, (unsigned short)data);
+        Font[widths + c] = Widths[c];
+        Put_Short(heights + c * 2, (unsigned short)(Tops[c] | (Lines[c] << 8)));
+
+        int bytes = Lines[c] * ((Widths[c] + 1) / 2);
+        for (int i = 0; i < bytes; i++) {
+            seed = seed * 1103515245 + 12345;
+            Font[data++] = (unsigned char)(seed >> 16);
+        }
+    }
+    Put_Short(0, (unsigned short)data);
+}
+
+/*
+**	The character drawing Buffer_Print did before it kept glyphs, one pixel at a time.
+*/
+static void Reference_Print(unsigned char* buffer, char const* string, int fground, int bground)
+{
+    unsigned char colors[16];
+    memcpy(colors, Get_Font_Palette_Ptr(), sizeof(colors));
+    colors[1] = fground;
+    colors[0] = bground;
+
+    int x = 0;
+    for (; *string != '\0'; string++) {
+        int c = (unsigned char)*string;
+        unsigned char const* char_data = Font + Get_Short(20 + c * 2);
+        unsigned char* dst = buffer + x;
+        int width = Widths[c];
+
+        for (int row = 0; row < Tops[c]; row++) {
+            if (colors[0]) {
+                memset(dst, colors[0], width);
+            }
+            dst += BUFFER_SIZE;
+        }
+
+        if (Lines[c]) {
+            for (int row = 0; row < Lines[c]; row++) {
+                for (int i = 0; i < width; i++) {
+                    unsigned char packed = char_data[i / 2];
+                    unsigned char color = colors[(i & 1) ? packed >> 4 : packed & 0x0F];
+                    if (color) {
+                        dst[i] = color;
+                    }
+                }
+                char_data += (width + 1) / 2;
+                dst += BUFFER_SIZE;
+            }
+
+            for (int row = Tops[c] + Lines[c]; row < FONT_HEIGHT; row++) {
+                if (colors[0]) {
+                    memset(dst, colors[0], width);
+                }
+                dst += BUFFER_SIZE;
+            }
+        }
+
+        x += width;
+    }
+}
+
+/*
+**	Every string must come out as the reference draws it, over a background that
+**	shows up any pixel written that shouldn't be, for each color pair. The second
+**	pass prints from the glyphs the first one made, and the third after the palette
+**	range has changed under them.
+*/
+int test_print(void)
+{
+    static const int colors[][2] = {{15, 0}, {15, 12}, {0, 3}, {200, 0}, {15, 0}};
+    static const char strings[][CHAR_COUNT + 1] = {
+        {1, 2, 3, 4, 5, 6, 7, 0}, {0}, {7, 7, 2, 0}, {5, 3, 1, 6, 0}, {4, 0}};
+    static unsigned char color_range[16];
+    unsigned char expected[BUFFER_SIZE * BUFFER_SIZE];
+
+    Make_Font();
+    Set_Font(Font);
+
+    GraphicBufferClass gb(BUFFER_SIZE, BUFFER_SIZE);
+
+    for (int pass = 0; pass < 3; pass++) {
+        for (int i = 0; i < 16; i++) {
+            color_range[i] = (unsigned char)(i * (pass < 2 ? 3 : 5) + 100);
+        }
+        Set_Font_Palette_Range(color_range, 0, 15);
+
+        for (unsigned c = 0; c < sizeof(colors) / sizeof(colors[0]); c++) {
+            for (unsigned s = 0; s < sizeof(strings) / sizeof(strings[0]); s++) {
+                gb.Clear(77);
+                memset(expected, 77, sizeof(expected));
+
+                Buffer_Print(&gb, strings[s], 0, 0, colors[c][0], colors[c][1]);
+                Reference_Print(expected, strings[s], colors[c][0], colors[c][1]);
+
+                if (memcmp(gb.Get_Buffer(), expected, sizeof(expected)) != 0) {
+                    printf("print: string %u in colors %d/%d wrong on pass %d\n", s, colors[c][0], colors[c][1], pass);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_print();
+
+    return ret;
+}
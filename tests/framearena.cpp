@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "common/framearena.h"
+
+static int Check(bool ok, const char* what)
+{
+    if (!ok) {
+        printf("%s\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+**	Allocations must be aligned, must not overlap, and must come back from the
+**	same place once the arena is rewound.
+*/
+int test_alloc(void)
+{
+    FrameArenaClass arena(1024);
+    int ret = 0;
+
+    unsigned char* a = (unsigned char*)arena.Alloc(10);
+    unsigned char* b = (unsigned char*)arena.Alloc(33);
+    ret |= Check(a != NULL && b != NULL, "alloc: failed");
+    ret |= Check(((uintptr_t)a % FrameArenaClass::ALIGNMENT) == 0, "alloc: first block not aligned");
+    ret |= Check(((uintptr_t)b % FrameArenaClass::ALIGNMENT) == 0, "alloc: second block not aligned");
+    ret |= Check(b >= a + 10, "alloc: blocks overlap");
+
+    size_t mark = arena.Mark();
+    unsigned char* c = (unsigned char*)arena.Alloc(100);
+    arena.Rewind(mark);
+    unsigned char* d = (unsigned char*)arena.Alloc(100);
+    ret |= Check(c == d, "alloc: rewind did not give the space back");
+
+    arena.Reset();
+    ret |= Check(arena.Alloc(10) == a, "alloc: reset did not give the space back");
+    ret |= Check(arena.Overflows() == 0, "alloc: overflowed without need");
+
+    return ret;
+}
+
+/*
+**	Requests bigger than the arena spill over to the heap, keep their contents,
+**	and make the arena grow to fit once it is empty again.
+*/
+int test_overflow(void)
+{
+    FrameArenaClass arena(256);
+    unsigned char* blocks[8];
+    int ret = 0;
+
+    for (int i = 0; i < 8; i++) {
+        blocks[i] = (unsigned char*)arena.Alloc(100);
+        memset(blocks[i], i, 100);
+    }
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 100; j++) {
+            if (blocks[i][j] != i) {
+                printf("overflow: block %d overwritten\n", i);
+                return 1;
+            }
+        }
+    }
+
+    ret |= Check(arena.Overflows() > 0, "overflow: no overflow counted");
+    ret |= Check(arena.High_Water() >= 800, "overflow: high water too low");
+
+    /*
+    **	Rewinding into the spilled part frees only what came after the mark.
+    */
+    arena.Reset();
+    for (int i = 0; i < 4; i++) {
+        arena.Alloc(100);
+    }
+    size_t mark = arena.Mark();
+    arena.Alloc(100);
+    arena.Rewind(mark);
+    ret |= Check(arena.Mark() == mark, "overflow: rewind lost track of the total");
+
+    arena.Reset();
+    ret |= Check(arena.Size() >= arena.High_Water(), "overflow: arena did not grow to the high water mark");
+
+    unsigned long overflows = arena.Overflows();
+    for (int i = 0; i < 8; i++) {
+        arena.Alloc(100);
+    }
+    ret |= Check(arena.Overflows() == overflows, "overflow: still overflowing after growing");
+
+    return ret;
+}
+
+/*
+**	A very large request must not grow the arena past MAX_SIZE, and once resets
+**	go by using far less than it holds, the arena must give the memory back.
+*/
+int test_trim(void)
+{
+    FrameArenaClass arena;
+    int ret = 0;
+
+    unsigned char* big = (unsigned char*)arena.Alloc(FrameArenaClass::MAX_SIZE * 4);
+    ret |= Check(big != NULL, "trim: big alloc failed");
+    memset(big, 1, FrameArenaClass::MAX_SIZE * 4);
+    arena.Reset();
+    ret |= Check(arena.Size() == FrameArenaClass::MAX_SIZE, "trim: arena did not stop growing at the cap");
+
+    for (int i = 0; i < FrameArenaClass::TRIM_RESETS * 2; i++) {
+        arena.Alloc(100);
+        arena.Reset();
+    }
+    ret |= Check(arena.Size() == FrameArenaClass::DEFAULT_SIZE, "trim: arena did not shrink back");
+    ret |= Check(arena.Alloc(100) != NULL, "trim: alloc failed after shrinking");
+
+    return ret;
+}
+
+int test_thread(void)
+{
+    FrameArenaClass& arena = FrameArenaClass::Thread();
+    int ret = 0;
+
+    ret |= Check(&arena == &FrameArenaClass::Thread(), "thread: arena changed between calls");
+    ret |= Check(arena.Alloc(16) != NULL, "thread: alloc failed");
+    arena.Reset();
+
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_alloc();
+    ret |= test_overflow();
+    ret |= test_trim();
+    ret |= test_thread();
+
+    return ret;
+}
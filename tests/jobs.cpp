@@ -0,0 +1,347 @@
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "common/jobs.h"
+
+/*
+**	Marks every index handed out by Parallel_For, so indices that are missed or
+**	given out twice show up.
+*/
+struct CoverData
+{
+    std::atomic<int>* Hits;
+    std::atomic<int> Calls;
+};
+
+static void Cover_Range(void* data, int first, int last)
+{
+    CoverData* cover = (CoverData*)data;
+
+    cover->Calls++;
+    for (int i = first; i < last; i++) {
+        cover->Hits[i]++;
+    }
+}
+
+int test_parallel_for(JobSystemClass& jobs, int first, int last, int grain)
+{
+    std::vector<std::atomic<int>> hits(last > 0 ? last : 1);
+    CoverData cover;
+    cover.Hits = hits.data();
+    cover.Calls = 0;
+
+    for (size_t i = 0; i < hits.size(); i++) {
+        hits[i] = 0;
+    }
+
+    jobs.Parallel_For(first, last, grain, Cover_Range, &cover);
+
+    for (int i = 0; i < (int)hits.size(); i++) {
+        int want = (i >= first && i < last) ? 1 : 0;
+        if (hits[i] != want) {
+            printf("parallel for [%d, %d) grain %d%s: index %d run %d times\n",
+                   first,
+                   last,
+                   grain,
+                   jobs.Is_Serial() ? " serial" : "",
+                   i,
+                   (int)hits[i]);
+            return 1;
+        }
+    }
+
+    int chunks = last > first ? (last - first + grain - 1) / grain : 0;
+    if (cover.Calls != chunks) {
+        printf("parallel for [%d, %d) grain %d: %d chunks, expected %d\n", first, last, grain, (int)cover.Calls, chunks);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+**	Each job records the order in which it started. A job must start after every
+**	job it depends on has finished.
+*/
+struct OrderData
+{
+    std::atomic<int>* Clock;
+    int Started;
+    int Finished;
+};
+
+static void Order_Job(void* data)
+{
+    OrderData* order = (OrderData*)data;
+
+    order->Started = (*order->Clock)++;
+    std::this_thread::yield();
+    order->Finished = (*order->Clock)++;
+}
+
+int test_dependencies(JobSystemClass& jobs)
+{
+    /*
+    **	A diamond repeated in layers: every job in a layer waits on every job in
+    **	the layer before it.
+    */
+    const int layers = 50;
+    const int width = 4;
+    std::atomic<int> clock(0);
+    OrderData order[layers][width];
+    JobClass* handles[layers][width];
+
+    for (int layer = 0; layer < layers; layer++) {
+        for (int i = 0; i < width; i++) {
+            order[layer][i].Clock = &clock;
+            handles[layer][i] =
+                jobs.Submit(Order_Job, &order[layer][i], layer > 0 ? handles[layer - 1] : NULL, layer > 0 ? width : 0);
+        }
+    }
+
+    for (int layer = 1; layer < layers; layer++) {
+        for (int i = 0; i < width; i++) {
+            jobs.Wait(handles[layer][i]);
+        }
+    }
+    for (int i = 0; i < width; i++) {
+        jobs.Release(handles[0][i]);
+    }
+    jobs.Wait_All();
+
+    for (int layer = 1; layer < layers; layer++) {
+        for (int i = 0; i < width; i++) {
+            for (int j = 0; j < width; j++) {
+                if (order[layer][i].Started < order[layer - 1][j].Finished) {
+                    printf("dependencies%s: job %d.%d started before %d.%d finished\n",
+                           jobs.Is_Serial() ? " serial" : "",
+                           layer,
+                           i,
+                           layer - 1,
+                           j);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+**	In serial mode jobs run at once, in order, on the thread that submits them.
+*/
+static void Serial_Job(void* data)
+{
+    std::vector<int>* log = (std::vector<int>*)data;
+    log->push_back((int)log->size());
+}
+
+int test_serial(JobSystemClass& jobs)
+{
+    std::vector<int> log;
+
+    jobs.Set_Serial(true);
+    for (int i = 0; i < 100; i++) {
+        JobClass* job = jobs.Submit(Serial_Job, &log);
+        if (!job->Is_Done()) {
+            printf("serial: job %d did not run on submission\n", i);
+            return 1;
+        }
+        jobs.Release(job);
+    }
+    jobs.Set_Serial(false);
+
+    for (int i = 0; i < (int)log.size(); i++) {
+        if (log[i] != i) {
+            printf("serial: job %d ran out of order\n", i);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+**	Every chunk fills scratch memory with its own pattern and checks nobody else
+**	wrote over it before it finished.
+*/
+struct ScratchData
+{
+    JobSystemClass* Jobs;
+    std::atomic<int> Errors;
+};
+
+static void Scratch_Range(void* data, int first, int last)
+{
+    ScratchData* test = (ScratchData*)data;
+
+    for (int i = first; i < last; i++) {
+        int size = 1000 + (i % 7) * 100;
+        unsigned char* mem = (unsigned char*)test->Jobs->Scratch_Alloc(size);
+        if (mem == NULL) {
+            test->Errors++;
+            return;
+        }
+        memset(mem, i & 0xFF, size);
+        std::this_thread::yield();
+        for (int j = 0; j < size; j++) {
+            if (mem[j] != (i & 0xFF)) {
+                test->Errors++;
+                return;
+            }
+        }
+    }
+}
+
+int test_scratch(JobSystemClass& jobs)
+{
+    ScratchData test;
+    test.Jobs = &jobs;
+    test.Errors = 0;
+
+    /*
+    **	Many more allocations are made than fit at once, so the space has to be
+    **	given back as each chunk ends.
+    */
+    for (int pass = 0; pass < 20; pass++) {
+        jobs.Parallel_For(0, 400, 4, Scratch_Range, &test);
+    }
+
+    if (test.Errors != 0) {
+        printf("scratch: %d chunks saw bad scratch memory\n", (int)test.Errors);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+**	Jobs that spawn and wait on jobs of their own.
+*/
+struct NestData
+{
+    JobSystemClass* Jobs;
+    std::atomic<int>* Count;
+    int Depth;
+};
+
+static void Nest_Job(void* data)
+{
+    NestData* nest = (NestData*)data;
+
+    (*nest->Count)++;
+    if (nest->Depth == 0) {
+        return;
+    }
+
+    NestData child[2] = {{nest->Jobs, nest->Count, nest->Depth - 1}, {nest->Jobs, nest->Count, nest->Depth - 1}};
+    JobClass* a = nest->Jobs->Submit(Nest_Job, &child[0]);
+    JobClass* b = nest->Jobs->Submit(Nest_Job, &child[1]);
+    nest->Jobs->Wait(a);
+    nest->Jobs->Wait(b);
+}
+
+int test_nested(JobSystemClass& jobs)
+{
+    std::atomic<int> count(0);
+    NestData root = {&jobs, &count, 10};
+
+    jobs.Wait(jobs.Submit(Nest_Job, &root));
+
+    if (count != (1 << 11) - 1) {
+        printf("nested: %d jobs ran, expected %d\n", (int)count, (1 << 11) - 1);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+**	Some floating point work per index, heavy enough that spreading it over the
+**	workers should show.
+*/
+struct BenchData
+{
+    float* Out;
+};
+
+static void Bench_Range(void* data, int first, int last)
+{
+    BenchData* bench = (BenchData*)data;
+
+    for (int i = first; i < last; i++) {
+        float x = (float)i;
+        for (int j = 0; j < 64; j++) {
+            x = x * 0.999f + 1.0f;
+        }
+        bench->Out[i] = x;
+    }
+}
+
+static void Empty_Job(void*)
+{
+}
+
+void bench_jobs(JobSystemClass& jobs)
+{
+    const int count = 1 << 18;
+    const int runs = 5;
+    std::vector<float> out(count);
+    BenchData bench = {out.data()};
+
+    for (int serial = 1; serial >= 0; serial--) {
+        jobs.Set_Serial(serial != 0);
+        auto start = std::chrono::steady_clock::now();
+        for (int run = 0; run < runs; run++) {
+            jobs.Parallel_For(0, count, 4096, Bench_Range, &bench);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("parallel for %d items, %s: %.3f ms per run\n", count, serial ? "serial" : "pooled", ms / runs);
+    }
+
+    const int empties = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < empties; i++) {
+        jobs.Release(jobs.Submit(Empty_Job, NULL));
+    }
+    jobs.Wait_All();
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    printf("submit and run %d empty jobs: %.3f us per job\n", empties, us / empties);
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    /*
+    **	A pool with no workers runs everything on the waiting thread, which has to
+    **	work as well as a real pool does.
+    */
+    static const int workers[] = {0, 1, 3, 7};
+    for (unsigned w = 0; w < sizeof(workers) / sizeof(workers[0]); w++) {
+        JobSystemClass jobs(workers[w], 16 * 1024);
+
+        for (int serial = 0; serial <= 1; serial++) {
+            jobs.Set_Serial(serial != 0);
+            ret |= test_parallel_for(jobs, 0, 1, 1);
+            ret |= test_parallel_for(jobs, 0, 1000, 1);
+            ret |= test_parallel_for(jobs, 0, 1000, 7);
+            ret |= test_parallel_for(jobs, 13, 100000, 256);
+            ret |= test_parallel_for(jobs, 5, 5, 3);
+            ret |= test_dependencies(jobs);
+            ret |= test_scratch(jobs);
+            ret |= test_nested(jobs);
+        }
+        jobs.Set_Serial(false);
+        ret |= test_serial(jobs);
+    }
+
+    JobSystemClass jobs;
+    printf("%d workers\n", jobs.Workers());
+    bench_jobs(jobs);
+
+    return ret;
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <string.h>
+#include "loopmgr.h"
+
+/*
+**	Runs a number of lockstep players over the loopback network, each talking
+**	through the game's own ConnectionClass ACK and retry logic. Every
+**	FrameSendRate frames each player sends the others the frame its commands
+**	will execute on, MaxAhead frames from now, and it may only run a frame once
+**	every other player has announced a frame at least that far on. This is the
+**	rule Can_Advance applies in queue.cpp, so the stalls and resends measured
+**	here are those a real match would see under the same network conditions.
+*/
+struct LockstepTest
+{
+    const char* Name;
+    int Players;
+    LoopbackLinkType Link;
+    int MaxAhead;
+    int FrameSendRate;
+    unsigned long RetryDelta;
+};
+
+struct FrameInfoPacket
+{
+    long Frame;
+    long Sequence;
+};
+
+enum
+{
+    TEST_FRAMES = 600,
+    TICKS_PER_FRAME = 4, // 15 frames per second at 60 ticks per second
+    TICK_LIMIT = TEST_FRAMES * TICKS_PER_FRAME * 20
+};
+
+static int Run_Lockstep(LockstepTest const& test)
+{
+    LoopbackNetClass net(test.Players, test.Link, 0x1234);
+    LoopbackConnManClass* conn[LoopbackNetClass::MAX_NODES];
+    long frame[LoopbackNetClass::MAX_NODES];
+    long next_send[LoopbackNetClass::MAX_NODES];
+    long sequence[LoopbackNetClass::MAX_NODES];
+    long their_frame[LoopbackNetClass::MAX_NODES][LoopbackNetClass::MAX_NODES];
+    long their_sequence[LoopbackNetClass::MAX_NODES][LoopbackNetClass::MAX_NODES];
+    unsigned long stalls = 0;
+    int ret = 0;
+
+    for (int i = 0; i < test.Players; i++) {
+        conn[i] = new LoopbackConnManClass(net, i);
+        conn[i]->Set_Timing(test.RetryDelta, 0xFFFFFFFF, 60 * 30);
+        frame[i] = 0;
+        next_send[i] = 0;
+        sequence[i] = 0;
+        for (int j = 0; j < test.Players; j++) {
+            their_frame[i][j] = -1;
+            their_sequence[i][j] = 0;
+        }
+    }
+
+    bool done = false;
+    while (!done && net.Time() < TICK_LIMIT) {
+        for (int i = 0; i < test.Players; i++) {
+            if (!conn[i]->Service()) {
+                fprintf(stderr, "%s: player %d lost its connection\n", test.Name, i);
+                ret = 1;
+                done = true;
+            }
+
+            FrameInfoPacket packet;
+            int len;
+            int id;
+            while (conn[i]->Get_Private_Message(&packet, &len, &id)) {
+                if (len != sizeof(packet) || packet.Sequence != their_sequence[i][id] + 1) {
+                    fprintf(stderr, "%s: player %d got packet %ld from %d out of order\n", test.Name, i, packet.Sequence, id);
+                    ret = 1;
+                }
+                their_sequence[i][id] = packet.Sequence;
+                their_frame[i][id] = packet.Frame;
+            }
+        }
+
+        /*
+        **	Players only try to run a frame on frame boundaries; if any peer has
+        **	not yet announced that frame, it's a stall and the frame waits.
+        */
+        if ((net.Time() % TICKS_PER_FRAME) == 0) {
+            done = true;
+            for (int i = 0; i < test.Players; i++) {
+                if (frame[i] >= TEST_FRAMES) {
+                    continue;
+                }
+
+                if (frame[i] == next_send[i]) {
+                    FrameInfoPacket packet;
+                    packet.Frame = frame[i] + test.MaxAhead;
+                    packet.Sequence = ++sequence[i];
+                    if (!conn[i]->Send_Private_Message(&packet, sizeof(packet))) {
+                        fprintf(stderr, "%s: player %d couldn't send frame %ld\n", test.Name, i, packet.Frame);
+                        ret = 1;
+                    }
+                    next_send[i] += test.FrameSendRate;
+                }
+
+                bool can_advance = true;
+                for (int j = 0; j < test.Players; j++) {
+                    if (j != i && frame[i] > test.MaxAhead - 1 && their_frame[i][j] < frame[i]) {
+                        can_advance = false;
+                    }
+                }
+
+                if (can_advance) {
+                    frame[i]++;
+                } else {
+                    stalls++;
+                }
+                if (frame[i] < TEST_FRAMES) {
+                    done = false;
+                }
+            }
+        }
+
+        net.Advance();
+    }
+
+    unsigned long resends = 0;
+    unsigned long response = 0;
+    for (int i = 0; i < test.Players; i++) {
+        if (frame[i] < TEST_FRAMES) {
+            fprintf(stderr, "%s: player %d only reached frame %ld\n", test.Name, i, frame[i]);
+            ret = 1;
+        }
+        resends += conn[i]->Resends();
+        if (conn[i]->Response_Time() > response) {
+            response = conn[i]->Response_Time();
+        }
+    }
+
+    double seconds = net.Time() / 60.0;
+    printf("%-12s players %d latency %3lu jitter %3lu loss %2d%% ahead %2d rate %d retry %2lu: "
+           "%5.2f fps, %5lu stalls, %5lu resends of %6lu packets, %6lu bytes, response %lu\n",
+           test.Name,
+           test.Players,
+           test.Link.Latency,
+           test.Link.Jitter,
+           test.Link.LossPercent,
+           test.MaxAhead,
+           test.FrameSendRate,
+           test.RetryDelta,
+           seconds > 0 ? TEST_FRAMES / seconds : 0.0,
+           stalls,
+           resends,
+           net.Packets_Sent(),
+           net.Bytes_Sent(),
+           response);
+
+    if (test.Link.LossPercent == 0 && test.Link.Jitter == 0 && resends != 0) {
+        fprintf(stderr, "%s: %lu resends on a perfect network\n", test.Name, resends);
+        ret = 1;
+    }
+
+    for (int i = 0; i < test.Players; i++) {
+        delete conn[i];
+    }
+
+    return ret;
+}
+
+/*
+**	With nothing getting through, a connection's send queue fills up. Once it's
+**	full Send_Private_Message must refuse the packet, for one peer or for all of
+**	them, and so must a send to a peer that isn't there. The retry logic then
+**	gives up on the connection.
+*/
+static int Run_Overflow(void)
+{
+    LoopbackLinkType dead = {1, 0, 100};
+    LoopbackNetClass net(3, dead);
+    LoopbackConnManClass conn(net, 0, 4, 4, 6, 5, 60 * 30);
+    FrameInfoPacket packet = {0, 0};
+    int ret = 0;
+
+    for (int i = 0; i < 4; i++) {
+        if (conn.Send_Private_Message(&packet, sizeof(packet), 1, 1) != 1) {
+            fprintf(stderr, "overflow: send %d to peer 1 was refused\n", i);
+            ret = 1;
+        }
+    }
+    if (conn.Send_Private_Message(&packet, sizeof(packet), 1, 1) != 0) {
+        fprintf(stderr, "overflow: send to a full queue was accepted\n");
+        ret = 1;
+    }
+    if (conn.Send_Private_Message(&packet, sizeof(packet)) != 0 || conn.Private_Num_Send(2) != 0) {
+        fprintf(stderr, "overflow: send to all with one full queue was accepted\n");
+        ret = 1;
+    }
+    if (conn.Send_Private_Message(&packet, sizeof(packet), 1, 2) != 1) {
+        fprintf(stderr, "overflow: send to peer 2 was refused\n");
+        ret = 1;
+    }
+    if (conn.Send_Private_Message(&packet, sizeof(packet), 1, 0) != 0) {
+        fprintf(stderr, "overflow: send to ourselves was accepted\n");
+        ret = 1;
+    }
+    if (conn.Send_Overflows() != 3) {
+        fprintf(stderr, "overflow: counted %lu overflows\n", conn.Send_Overflows());
+        ret = 1;
+    }
+
+    bool lost = false;
+    while (!lost && net.Time() < 60 * 10) {
+        lost = !conn.Service();
+        net.Advance();
+    }
+    if (!lost) {
+        fprintf(stderr, "overflow: connection never gave up\n");
+        ret = 1;
+    }
+
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    static const LockstepTest tests[] = {
+        {"lan", 2, {1, 0, 0}, 8, 3, 6},
+        {"lan-8", 8, {1, 0, 0}, 8, 3, 6},
+        {"internet", 4, {9, 3, 2}, 16, 4, 24},
+        {"lossy", 4, {9, 6, 10}, 16, 4, 24},
+        {"lossy-8", 8, {15, 6, 10}, 24, 5, 40},
+        {"tight-ahead", 4, {9, 3, 2}, 8, 4, 24},
+        {"eager-retry", 4, {9, 3, 2}, 16, 4, 6},
+    };
+
+    int ret = Run_Overflow();
+    for (unsigned i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        ret |= Run_Lockstep(tests[i]);
+    }
+
+    return ret;
+}
@@ -0,0 +1,374 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "loopmgr.h"
+#include "common/framearena.h"
+#include "common/ftimer.h"
+#include <string.h>
+
+/*
+**	The game's clock, which ConnectionClass::Time reads once the timer system is
+**	on. It's kept stopped and only set from the loopback network's clock.
+*/
+TTimerClass<SystemTimerClass> TickCount;
+
+static void Set_Tick_Count(unsigned long ticks)
+{
+    /*
+    **	A timer can only be given a value by starting it from there, so stop it
+    **	again straight away, and go round again if the system tick moved between.
+    */
+    do {
+        TickCount = TTimerClass<SystemTimerClass>(ticks);
+        TickCount.Stop();
+    } while (TickCount.Value() != ticks);
+}
+
+LoopbackNetClass::LoopbackNetClass(int numnodes, LoopbackLinkType const& link, unsigned seed)
+    : NumNodes(numnodes < MAX_NODES ? numnodes : MAX_NODES)
+    , Link(link)
+    , Random(seed)
+    , Clock(0)
+    , Sequence(0)
+    , NumSent(0)
+    , NumDropped(0)
+    , NumBytes(0)
+{
+    InFlight = new InFlightType[MAX_IN_FLIGHT];
+    for (int i = 0; i < MAX_IN_FLIGHT; i++) {
+        InFlight[i].IsActive = false;
+        InFlight[i].Buffer = new char[MAX_PACKET];
+    }
+
+    TimerSystemOn = true;
+    Set_Tick_Count(TICK_BASE);
+}
+
+LoopbackNetClass::~LoopbackNetClass()
+{
+    for (int i = 0; i < MAX_IN_FLIGHT; i++) {
+        delete[] InFlight[i].Buffer;
+    }
+    delete[] InFlight;
+}
+
+void LoopbackNetClass::Advance(unsigned long ticks)
+{
+    Clock += ticks;
+    Set_Tick_Count(TICK_BASE + Clock);
+}
+
+/*
+**	Puts a packet on the wire. A dropped packet still counts as sent, just as
+**	it would for a real socket; false is only returned for a bad request or
+**	when too many packets are already in flight.
+*/
+bool LoopbackNetClass::Send(int from, int to, void const* buf, int buflen)
+{
+    if ((unsigned)from >= (unsigned)NumNodes || (unsigned)to >= (unsigned)NumNodes || buflen > MAX_PACKET) {
+        return false;
+    }
+
+    NumSent++;
+    NumBytes += buflen;
+
+    if (Link.LossPercent > 0 && Random(0, 99) < Link.LossPercent) {
+        NumDropped++;
+        return true;
+    }
+
+    for (int i = 0; i < MAX_IN_FLIGHT; i++) {
+        InFlightType& packet = InFlight[i];
+        if (!packet.IsActive) {
+            packet.IsActive = true;
+            packet.From = from;
+            packet.To = to;
+            packet.DeliverTime = Clock + Link.Latency;
+            if (Link.Jitter > 0) {
+                packet.DeliverTime += Random(0, (int)Link.Jitter);
+            }
+            packet.Sequence = Sequence++;
+            packet.BufLen = buflen;
+            memcpy(packet.Buffer, buf, buflen);
+            return true;
+        }
+    }
+
+    NumDropped++;
+    return false;
+}
+
+/*
+**	Fetches the packet for 'node' that arrived first, if any has arrived yet.
+*/
+bool LoopbackNetClass::Receive(int node, void* buf, int* buflen, int* from)
+{
+    InFlightType* best = NULL;
+
+    for (int i = 0; i < MAX_IN_FLIGHT; i++) {
+        InFlightType& packet = InFlight[i];
+        if (packet.IsActive && packet.To == node && packet.DeliverTime <= Clock) {
+            if (best == NULL || packet.DeliverTime < best->DeliverTime
+                || (packet.DeliverTime == best->DeliverTime && packet.Sequence < best->Sequence)) {
+                best = &packet;
+            }
+        }
+    }
+
+    if (best == NULL) {
+        return false;
+    }
+
+    memcpy(buf, best->Buffer, best->BufLen);
+    *buflen = best->BufLen;
+    *from = best->From;
+    best->IsActive = false;
+    return true;
+}
+
+LoopbackConnClass::LoopbackConnClass(LoopbackNetClass& net,
+                                     int node,
+                                     int peer,
+                                     int numsend,
+                                     int numreceive,
+                                     unsigned long retrydelta,
+                                     unsigned long maxretries,
+                                     unsigned long timeout)
+    : ConnectionClass(numsend,
+                      numreceive,
+                      LoopbackNetClass::MAX_PACKET - sizeof(CommHeaderType),
+                      LoopbackConnManClass::MAGIC_NUM,
+                      retrydelta,
+                      maxretries,
+                      timeout)
+    , Net(net)
+    , Node(node)
+    , Peer(peer)
+    , NumDataSends(0)
+{
+    Init();
+}
+
+/*
+**	Called by the retry logic for every packet it [re]sends, and for the ACKs.
+*/
+int LoopbackConnClass::Send(char* buf, int buflen, void* extrabuf, int extralen)
+{
+    if (((CommHeaderType*)buf)->Code == PACKET_DATA_ACK) {
+        NumDataSends++;
+    }
+    return (Net.Send(Node, Peer, buf, buflen) ? 1 : 0);
+}
+
+LoopbackConnManClass::LoopbackConnManClass(LoopbackNetClass& net,
+                                           int node,
+                                           int numsend,
+                                           int numreceive,
+                                           unsigned long retrydelta,
+                                           unsigned long maxretries,
+                                           unsigned long timeout)
+    : Net(net)
+    , Node(node)
+    , CurConnection(0)
+    , SendOverflows(0)
+{
+    for (int i = 0; i < LoopbackNetClass::MAX_NODES; i++) {
+        Connection[i] = NULL;
+        if (i != Node && i < Net.Num_Nodes()) {
+            Connection[i] =
+                new LoopbackConnClass(Net, Node, i, numsend, numreceive, retrydelta, maxretries, timeout);
+        }
+    }
+}
+
+LoopbackConnManClass::~LoopbackConnManClass()
+{
+    for (int i = 0; i < LoopbackNetClass::MAX_NODES; i++) {
+        delete Connection[i];
+    }
+}
+
+/*
+**	Hands everything that has arrived to the connection it's from, then lets
+**	each connection [re]send and ACK. Returns 0 if a connection has run out of
+**	retries or timed out, meaning that peer should be considered lost.
+*/
+int LoopbackConnManClass::Service(void)
+{
+    int buflen;
+    int from;
+    int rc = 1;
+    FrameArenaClass& arena = FrameArenaClass::Thread();
+    size_t mark = arena.Mark();
+    char* buf = (char*)arena.Alloc(LoopbackNetClass::MAX_PACKET);
+
+    while (Net.Receive(Node, buf, &buflen, &from)) {
+        if (Connection[from] != NULL) {
+            Connection[from]->Receive_Packet(buf, buflen);
+        }
+    }
+    arena.Rewind(mark);
+
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL && !Connection[i]->Service()) {
+            rc = 0;
+        }
+    }
+
+    return (rc);
+}
+
+/*
+**	Queues a packet for one peer, or for all of them if conn_id is
+**	CONNECTION_NONE. As with the IPX manager, nothing is queued unless every
+**	connection it goes to has room, and 0 is returned if one didn't.
+*/
+int LoopbackConnManClass::Send_Private_Message(void* buf, int buflen, int ack_req, int conn_id)
+{
+    if (conn_id != CONNECTION_NONE && Connection_Index(conn_id) == CONNECTION_NONE) {
+        SendOverflows++;
+        return (0);
+    }
+
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL && (conn_id == CONNECTION_NONE || conn_id == i)
+            && Connection[i]->Queue->Num_Send() == Connection[i]->Queue->Max_Send()) {
+            SendOverflows++;
+            return (0);
+        }
+    }
+
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL && (conn_id == CONNECTION_NONE || conn_id == i)) {
+            Connection[i]->Send_Packet(buf, buflen, ack_req);
+        }
+    }
+
+    return (1);
+}
+
+/*
+**	Hands the application the next packet from the connections in turn, each of
+**	which gives out the packets that needed an ACK in the order they were sent.
+*/
+int LoopbackConnManClass::Get_Private_Message(void* buf, int* buflen, int* conn_id)
+{
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        int id = CurConnection;
+
+        CurConnection = (CurConnection + 1) % Net.Num_Nodes();
+        if (Connection[id] != NULL && Connection[id]->Get_Packet(buf, buflen)) {
+            *conn_id = id;
+            return (1);
+        }
+    }
+
+    return (0);
+}
+
+int LoopbackConnManClass::Num_Connections(void)
+{
+    return (Net.Num_Nodes() - 1);
+}
+
+int LoopbackConnManClass::Connection_ID(int index)
+{
+    if (index < 0 || index >= Num_Connections()) {
+        return (CONNECTION_NONE);
+    }
+    return (index < Node ? index : index + 1);
+}
+
+int LoopbackConnManClass::Connection_Index(int id)
+{
+    if (id < 0 || id >= Net.Num_Nodes() || id == Node) {
+        return (CONNECTION_NONE);
+    }
+    return (id < Node ? id : id - 1);
+}
+
+int LoopbackConnManClass::Global_Num_Send(void)
+{
+    return (Private_Num_Send());
+}
+
+int LoopbackConnManClass::Global_Num_Receive(void)
+{
+    return (Private_Num_Receive());
+}
+
+int LoopbackConnManClass::Private_Num_Send(int id)
+{
+    int count = 0;
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL && (id == CONNECTION_NONE || id == i)) {
+            count += Connection[i]->Queue->Num_Send();
+        }
+    }
+    return (count);
+}
+
+int LoopbackConnManClass::Private_Num_Receive(int id)
+{
+    int count = 0;
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL && (id == CONNECTION_NONE || id == i)) {
+            count += Connection[i]->Queue->Num_Receive();
+        }
+    }
+    return (count);
+}
+
+void LoopbackConnManClass::Reset_Response_Time(void)
+{
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL) {
+            Connection[i]->Queue->Reset_Response_Time();
+        }
+    }
+}
+
+/*
+**	Like the other managers, reports the slowest of the peers' average response
+**	times, since that is the one the game has to wait for.
+*/
+unsigned long LoopbackConnManClass::Response_Time(void)
+{
+    unsigned long maxresp = 0;
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL && Connection[i]->Queue->Avg_Response_Time() > maxresp) {
+            maxresp = Connection[i]->Queue->Avg_Response_Time();
+        }
+    }
+    return (maxresp);
+}
+
+void LoopbackConnManClass::Set_Timing(unsigned long retrydelta, unsigned long maxretries, unsigned long timeout)
+{
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL) {
+            Connection[i]->Set_Retry_Delta(retrydelta);
+            Connection[i]->Set_Max_Retries(maxretries);
+            Connection[i]->Set_TimeOut(timeout);
+        }
+    }
+}
+
+unsigned long LoopbackConnManClass::Resends(void) const
+{
+    unsigned long resends = 0;
+    for (int i = 0; i < Net.Num_Nodes(); i++) {
+        if (Connection[i] != NULL) {
+            resends += Connection[i]->Resends();
+        }
+    }
+    return (resends);
+}
@@ -0,0 +1,194 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef LOOPMGR_H
+#define LOOPMGR_H
+
+#include <stddef.h>
+#include "common/connmgr.h"
+#include "common/random.h"
+#include "redalert/connect.h"
+
+/*
+**	Conditions applied to every packet crossing the loopback network. Times are
+**	in ticks (60ths of a second), the same unit the connection retry logic uses.
+*/
+typedef struct
+{
+    unsigned long Latency; // one-way delay of every packet
+    unsigned long Jitter;  // maximum extra random delay, packets may arrive out of order
+    int LossPercent;       // chance of any one packet being dropped
+} LoopbackLinkType;
+
+/*
+**	Simulates a datagram network between a number of nodes in the same process.
+**	Nothing is ever delivered before its time, and time only moves when Advance
+**	is called, so a run with a given seed is repeatable. The clock also drives
+**	TickCount, which the connections' retry logic reads.
+*/
+class LoopbackNetClass
+{
+public:
+    enum LoopbackNetEnum
+    {
+        MAX_NODES = 8,
+        MAX_PACKET = 600,
+        MAX_IN_FLIGHT = 1024,
+        TICK_BASE = 60 * 60 // TickCount when the clock reads zero, the retry logic expects a running clock
+    };
+
+    LoopbackNetClass(int numnodes, LoopbackLinkType const& link, unsigned seed = 1);
+    ~LoopbackNetClass();
+
+    int Num_Nodes(void) const
+    {
+        return (NumNodes);
+    }
+    unsigned long Time(void) const
+    {
+        return (Clock);
+    }
+    void Advance(unsigned long ticks = 1);
+
+    bool Send(int from, int to, void const* buf, int buflen);
+    bool Receive(int node, void* buf, int* buflen, int* from);
+
+    unsigned long Packets_Sent(void) const
+    {
+        return (NumSent);
+    }
+    unsigned long Packets_Dropped(void) const
+    {
+        return (NumDropped);
+    }
+    unsigned long Bytes_Sent(void) const
+    {
+        return (NumBytes);
+    }
+
+private:
+    typedef struct
+    {
+        bool IsActive;
+        int From;
+        int To;
+        unsigned long DeliverTime;
+        unsigned long Sequence;
+        int BufLen;
+        char* Buffer;
+    } InFlightType;
+
+    int NumNodes;
+    LoopbackLinkType Link;
+    RandomClass Random;
+    unsigned long Clock;
+    unsigned long Sequence;
+    InFlightType* InFlight;
+
+    unsigned long NumSent;
+    unsigned long NumDropped;
+    unsigned long NumBytes;
+};
+
+/*
+**	One end of a connection over the loopback network. All the ACK and retry
+**	logic is the game's own ConnectionClass; this only puts its packets on the
+**	wire, and counts the ones that were sent again.
+*/
+class LoopbackConnClass : public ConnectionClass
+{
+public:
+    LoopbackConnClass(LoopbackNetClass& net,
+                      int node,
+                      int peer,
+                      int numsend,
+                      int numreceive,
+                      unsigned long retrydelta,
+                      unsigned long maxretries,
+                      unsigned long timeout);
+
+    unsigned long Resends(void) const
+    {
+        return (NumDataSends - NumSendAck);
+    }
+
+protected:
+    virtual int Send(char* buf, int buflen, void* extrabuf, int extralen);
+
+private:
+    LoopbackNetClass& Net;
+    int Node;
+    int Peer;
+    unsigned long NumDataSends;
+};
+
+/*
+**	Connection manager for one node of a LoopbackNetClass, laid out like the IPX
+**	manager: one LoopbackConnClass per peer, fed from the wire by Service. The
+**	connection ID of a peer is its node number.
+*/
+class LoopbackConnManClass : public ConnManClass
+{
+public:
+    enum LoopbackConnManEnum
+    {
+        MAGIC_NUM = 0x1234
+    };
+
+    LoopbackConnManClass(LoopbackNetClass& net,
+                         int node,
+                         int numsend = 64,
+                         int numreceive = 64,
+                         unsigned long retrydelta = 6,
+                         unsigned long maxretries = 0xFFFFFFFF,
+                         unsigned long timeout = 60 * 30);
+    virtual ~LoopbackConnManClass();
+
+    virtual int Service(void);
+
+    virtual int Send_Private_Message(void* buf, int buflen, int ack_req = 1, int conn_id = CONNECTION_NONE);
+    virtual int Get_Private_Message(void* buf, int* buflen, int* conn_id);
+
+    virtual int Num_Connections(void);
+    virtual int Connection_ID(int index);
+    virtual int Connection_Index(int id);
+
+    virtual int Global_Num_Send(void);
+    virtual int Global_Num_Receive(void);
+    virtual int Private_Num_Send(int id = CONNECTION_NONE);
+    virtual int Private_Num_Receive(int id = CONNECTION_NONE);
+
+    virtual void Reset_Response_Time(void);
+    virtual unsigned long Response_Time(void);
+    virtual void Set_Timing(unsigned long retrydelta, unsigned long maxretries, unsigned long timeout);
+
+    virtual void Configure_Debug(int index, int type_offset, int type_size, char** names, int namestart, int namecount)
+    {
+    }
+    virtual void Mono_Debug_Print(int index, int refresh)
+    {
+    }
+
+    unsigned long Resends(void) const;
+    unsigned long Send_Overflows(void) const
+    {
+        return (SendOverflows);
+    }
+
+private:
+    LoopbackNetClass& Net;
+    int Node;
+    LoopbackConnClass* Connection[LoopbackNetClass::MAX_NODES];
+    int CurConnection;
+    unsigned long SendOverflows;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include "common/palconv.h"
+
+static const uint32_t SENTINEL = 0xDEADBEEF;
+
+static uint32_t Lut[256];
+static unsigned Seed = 0x1234567;
+
+static unsigned Next_Random()
+{
+    Seed = Seed * 1103515245 + 12345;
+    return Seed >> 8;
+}
+
+static void Fill_Random(unsigned char* buf, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        buf[i] = Next_Random() & 0xFF;
+    }
+}
+
+static void Build_Tables()
+{
+    for (int i = 0; i < 256; ++i) {
+        Lut[i] = Next_Random() | 0xFF000000;
+    }
+}
+
+static int Compare(const char* name, const uint32_t* got, const uint32_t* want, int width, int height)
+{
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (got[y * width + x] != want[y * width + x]) {
+                printf("%s: pixel %d,%d is %08X, expected %08X\n", name, x, y, got[y * width + x], want[y * width + x]);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int test_expand(int width, int height)
+{
+    /*
+    ** Leave a gap at the end of each row so pitches differ from widths.
+    */
+    int src_pitch = width + 3;
+    int dst_width = width + 5;
+    int dst_height = height;
+    unsigned char* src = new unsigned char[src_pitch * height];
+    uint32_t* got = new uint32_t[dst_width * dst_height];
+    uint32_t* want = new uint32_t[dst_width * dst_height];
+    char name[64];
+    int ret;
+
+    Fill_Random(src, src_pitch * height);
+
+    for (int i = 0; i < dst_width * dst_height; ++i) {
+        got[i] = SENTINEL;
+        want[i] = SENTINEL;
+    }
+
+    for (int y = 0; y < dst_height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            want[y * dst_width + x] = Lut[src[y * src_pitch + x]];
+        }
+    }
+
+    Palette_Expand(got, dst_width * 4, src, src_pitch, width, height, Lut);
+
+    snprintf(name, sizeof(name), "expand %dx%d", width, height);
+    ret = Compare(name, got, want, dst_width, dst_height);
+
+    delete[] src;
+    delete[] got;
+    delete[] want;
+
+    return ret;
+}
+
+void bench_expand()
+{
+    const int width = 640;
+    const int height = 400;
+    const int frames = 100;
+    unsigned char* src = new unsigned char[width * height];
+    uint32_t* dst = new uint32_t[width * height];
+
+    Fill_Random(src, width * height);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; ++frame) {
+        Palette_Expand(dst, width * 4, src, width, width, height, Lut);
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("expand %dx%d: %.3f ms per frame\n", width, height, ms / frames);
+
+    delete[] src;
+    delete[] dst;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    Build_Tables();
+
+    ret |= test_expand(1, 1);
+    ret |= test_expand(37, 13);
+    ret |= test_expand(640, 400);
+    ret |= test_expand(1920, 1080);
+
+    bench_expand();
+
+    return ret;
+}
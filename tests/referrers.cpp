@@ -0,0 +1,144 @@
+#include "redalert/referrers.h"
+
+#include <stdio.h>
+
+#define KINDS   3
+#define OBJECTS 64
+
+typedef ReferrerTableClass<KINDS, long> TableType;
+
+/*
+**	Targets are a kind times a thousand plus an ID. Each object holds at most one target
+**	at a time, as though it only had a targeting computer.
+*/
+static long Held[OBJECTS];
+
+static long Target(int kind, unsigned id)
+{
+    return (kind * 1000 + id);
+}
+
+static bool Holds(long referrer, long target)
+{
+    return (Held[referrer] == target);
+}
+
+static void Assign(TableType& table, long referrer, long target)
+{
+    Held[referrer] = target;
+    if (target >= 0) {
+        table.Add(target / 1000, target % 1000, target, referrer, Holds);
+    }
+}
+
+/*
+**	Every object still holding a target must be listed for it, whatever else it held in
+**	between; that is all the detach relies on.
+*/
+static int Check_Listed(TableType const& table, char const* name)
+{
+    for (long referrer = 0; referrer < OBJECTS; referrer++) {
+        long target = Held[referrer];
+        if (target >= 0 && !table.Is_Listed(target / 1000, target % 1000, referrer)) {
+            printf("%s: object %ld holds %ld but is not listed\n", name, referrer, target);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int test_listed(void)
+{
+    TableType table;
+    unsigned seed = 4321;
+
+    for (int i = 0; i < OBJECTS; i++) {
+        Held[i] = -1;
+    }
+
+    /*
+    **	Objects keep switching between a handful of targets, so the lists fill up with
+    **	objects that have moved on and must be pruned without losing the ones that stay.
+    */
+    for (int step = 0; step < 10000; step++) {
+        seed = seed * 1103515245 + 12345;
+        long referrer = (seed >> 8) % OBJECTS;
+        int kind = (seed >> 16) % KINDS;
+        unsigned id = (seed >> 20) % 4;
+        Assign(table, referrer, (seed & 0x80000000) ? -1 : Target(kind, id));
+
+        if (Check_Listed(table, "listed")) {
+            return 1;
+        }
+    }
+
+    for (int kind = 0; kind < KINDS; kind++) {
+        for (unsigned id = 0; id < 4; id++) {
+            std::vector<long> const* list = table.Get(kind, id);
+            if (list != NULL && list->size() > 2 * OBJECTS) {
+                printf("listed: list of %d %u grew to %d\n", kind, id, (int)list->size());
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+**	Listing the same object twice keeps one entry, pruning drops only the objects that
+**	let go, and out of range kinds are ignored.
+*/
+int test_prune(void)
+{
+    TableType table;
+    long target = Target(1, 7);
+
+    for (int i = 0; i < OBJECTS; i++) {
+        Held[i] = -1;
+    }
+
+    Assign(table, 3, target);
+    Assign(table, 3, target);
+    Assign(table, 5, target);
+    Assign(table, 9, target);
+    std::vector<long> const* list = table.Get(1, 7);
+    if (list == NULL || list->size() != 3) {
+        printf("prune: expected three referrers\n");
+        return 1;
+    }
+
+    Held[5] = -1;
+    table.Prune(1, 7, target, Holds);
+    list = table.Get(1, 7);
+    if (list == NULL || list->size() != 2 || table.Is_Listed(1, 7, 5) || !table.Is_Listed(1, 7, 3)
+        || !table.Is_Listed(1, 7, 9)) {
+        printf("prune: wrong referrers left\n");
+        return 1;
+    }
+
+    table.Add(KINDS, 0, Target(KINDS, 0), 1, Holds);
+    table.Add(-1, 0, -1000, 1, Holds);
+    if (table.Get(0, 7) != NULL || table.Get(KINDS, 0) != NULL) {
+        printf("prune: a target nobody holds has referrers\n");
+        return 1;
+    }
+
+    table.Clear();
+    if (table.Get(1, 7) != NULL) {
+        printf("prune: clear left referrers\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_listed();
+    ret |= test_prune();
+
+    return ret;
+}
@@ -0,0 +1,181 @@
+#include "redalert/scanchange.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define HOUSES  4
+#define KINDS   2
+#define ACTIVE  0x80
+#define OBJECTS 8
+
+typedef ScanChangeClass<HOUSES, KINDS, ACTIVE> ChangesType;
+
+/*
+**	A heap of objects, each with an owner and the record the scan counts keep for it.
+*/
+struct ObjectType
+{
+    int Kind;
+    int House;
+    bool IsActive;
+    unsigned char Record;
+};
+
+static ObjectType Objects[OBJECTS];
+
+static void Scan_Set(ChangesType& changes, ObjectType& obj, bool counted)
+{
+    unsigned char value = counted ? (unsigned char)((obj.House + 1) | (obj.IsActive ? ACTIVE : 0)) : 0;
+    changes.Set(obj.Kind, obj.Record, value);
+}
+
+/*
+**	Like the team recruit pools: a house's list of objects of a kind, only made again
+**	from the heap when the change count has moved on since it was last made.
+*/
+struct PoolType
+{
+    bool IsValid;
+    unsigned long Changes;
+    int Count;
+    int Members[OBJECTS];
+    int Builds;
+};
+
+static PoolType const& Owned_Pool(ChangesType const& changes, PoolType& pool, int house, int kind)
+{
+    if (!pool.IsValid || pool.Changes != changes.Get(house, kind)) {
+        pool.Count = 0;
+        for (int i = 0; i < OBJECTS; i++) {
+            if (Objects[i].Kind == kind && Objects[i].House == house) {
+                pool.Members[pool.Count++] = i;
+            }
+        }
+        pool.Changes = changes.Get(house, kind);
+        pool.IsValid = true;
+        pool.Builds++;
+    }
+    return (pool);
+}
+
+static bool In_Pool(PoolType const& pool, int index)
+{
+    for (int i = 0; i < pool.Count; i++) {
+        if (pool.Members[i] == index) {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+/*
+**	An engineer takes a building: the old owner stops counting it and starts again while
+**	it still owns it, and only then does the owner change and the record get updated,
+**	the order TechnoClass::Captured does it in. Both houses' pools must notice, and no
+**	other house's or kind's.
+*/
+int test_capture(void)
+{
+    ChangesType changes;
+    PoolType pools[HOUSES][KINDS];
+
+    memset(pools, 0, sizeof(pools));
+    for (int i = 0; i < OBJECTS; i++) {
+        Objects[i].Kind = i % KINDS;
+        Objects[i].House = i % HOUSES;
+        Objects[i].IsActive = true;
+        Objects[i].Record = 0;
+        Scan_Set(changes, Objects[i], true);
+    }
+
+    for (int house = 0; house < HOUSES; house++) {
+        for (int kind = 0; kind < KINDS; kind++) {
+            Owned_Pool(changes, pools[house][kind], house, kind);
+        }
+    }
+
+    ObjectType& building = Objects[1];
+    int from = building.House;
+    int to = 3;
+
+    Scan_Set(changes, building, false);
+    Scan_Set(changes, building, true);
+    building.House = to;
+    Scan_Set(changes, building, true);
+
+    if (!In_Pool(Owned_Pool(changes, pools[to][building.Kind], to, building.Kind), 1)) {
+        printf("capture: the new owner's pool is missing the captured object\n");
+        return 1;
+    }
+    if (In_Pool(Owned_Pool(changes, pools[from][building.Kind], from, building.Kind), 1)) {
+        printf("capture: the old owner's pool still has the captured object\n");
+        return 1;
+    }
+
+    for (int house = 0; house < HOUSES; house++) {
+        for (int kind = 0; kind < KINDS; kind++) {
+            Owned_Pool(changes, pools[house][kind], house, kind);
+            bool touched = kind == building.Kind && (house == from || house == to);
+            if (pools[house][kind].Builds != (touched ? 2 : 1)) {
+                printf("capture: pool of house %d kind %d made %d times\n", house, kind, pools[house][kind].Builds);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+**	Records that only change the active flag, or don't change at all, leave the owner's
+**	pools alone; starting and stopping being counted doesn't, and clearing everything
+**	changes every pool.
+*/
+int test_changes(void)
+{
+    ChangesType changes;
+    ObjectType obj = {1, 2, false, 0};
+
+    Scan_Set(changes, obj, true);
+    unsigned long count = changes.Get(2, 1);
+    if (count == 0) {
+        printf("changes: starting to count an object changed nothing\n");
+        return 1;
+    }
+
+    obj.IsActive = true;
+    Scan_Set(changes, obj, true);
+    Scan_Set(changes, obj, true);
+    if (changes.Get(2, 1) != count) {
+        printf("changes: the active flag changed the owner\n");
+        return 1;
+    }
+
+    Scan_Set(changes, obj, false);
+    if (changes.Get(2, 1) == count || changes.Get(2, 0) != 0 || changes.Get(1, 1) != 0) {
+        printf("changes: stopping counting an object changed the wrong counts\n");
+        return 1;
+    }
+
+    changes.Change_All();
+    for (int house = 0; house < HOUSES; house++) {
+        for (int kind = 0; kind < KINDS; kind++) {
+            if (changes.Get(house, kind) == 0) {
+                printf("changes: house %d kind %d missed a change to everything\n", house, kind);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_capture();
+    ret |= test_changes();
+
+    return ret;
+}
@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <string.h>
+#include "common/telemetry.h"
+
+enum
+{
+    FIELD_THINK,
+    FIELD_UNITS,
+    FIELD_PATHS = 5
+};
+
+static void Define_Fields(TelemetryClass& telemetry)
+{
+    telemetry.Define(FIELD_THINK, "think", TelemetryClass::FIELD_TIMER);
+    telemetry.Define(FIELD_UNITS, "units", TelemetryClass::FIELD_VALUE);
+    telemetry.Define(FIELD_PATHS, "paths", TelemetryClass::FIELD_COUNT);
+}
+
+/*
+**	Records the given number of frames, with the frame number as the unit count
+**	and twice that many path calls.
+*/
+static void Record_Frames(TelemetryClass& telemetry, int frames)
+{
+    for (int frame = 0; frame < frames; frame++) {
+        telemetry.Begin(FIELD_THINK);
+        telemetry.End(FIELD_THINK);
+        telemetry.End(FIELD_THINK);
+        if (frame % 2 == 0) {
+            telemetry.Set(FIELD_UNITS, frame);
+        }
+        telemetry.Add(FIELD_PATHS, frame);
+        telemetry.Add(FIELD_PATHS, frame);
+        telemetry.End_Frame(frame);
+    }
+}
+
+static int Read_File(char const* name, char* buffer, int size)
+{
+    FILE* file = fopen(name, "r");
+    if (file == NULL) {
+        return 0;
+    }
+    int read = (int)fread(buffer, 1, size - 1, file);
+    buffer[read] = '\0';
+    fclose(file);
+    return read;
+}
+
+/*
+**	Every frame must come out once, in order, with counts cleared between frames
+**	and values held until they are set again. More frames are recorded than fit
+**	in the ring so that it has to be flushed on the way.
+*/
+int test_csv(void)
+{
+    static char text[256 * 1024];
+    char const* name = "test_telemetry.csv";
+    int frames = TelemetryClass::RING_FRAMES * 2 + 10;
+
+    TelemetryClass telemetry;
+    Define_Fields(telemetry);
+    if (!telemetry.Open(name)) {
+        printf("csv: could not open %s\n", name);
+        return 1;
+    }
+    Record_Frames(telemetry, frames);
+    telemetry.Close();
+
+    Read_File(name, text, sizeof(text));
+    remove(name);
+
+    char* line = strtok(text, "\n");
+    if (line == NULL || strcmp(line, "frame,think_us,think_calls,units,paths") != 0) {
+        printf("csv: bad header '%s'\n", line ? line : "");
+        return 1;
+    }
+
+    for (int frame = 0; frame < frames; frame++) {
+        long long number, us, calls, units, paths;
+
+        line = strtok(NULL, "\n");
+        if (line == NULL || sscanf(line, "%lld,%lld,%lld,%lld,%lld", &number, &us, &calls, &units, &paths) != 5) {
+            printf("csv: frame %d missing\n", frame);
+            return 1;
+        }
+        if (number != frame || calls != 1 || us < 0 || units != frame - frame % 2 || paths != frame * 2) {
+            printf("csv: frame %d wrong: %s\n", frame, line);
+            return 1;
+        }
+    }
+
+    if (strtok(NULL, "\n") != NULL) {
+        printf("csv: extra lines\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_json(void)
+{
+    static char text[64 * 1024];
+    char const* name = "test_telemetry.jsonl";
+
+    TelemetryClass telemetry;
+    Define_Fields(telemetry);
+    telemetry.Open(name);
+    Record_Frames(telemetry, 3);
+    telemetry.Close();
+
+    Read_File(name, text, sizeof(text));
+    remove(name);
+
+    char const* want = "{\"frame\":2,\"think_us\":";
+    char const* last = strstr(text, want);
+    if (last == NULL || strstr(last, "\"think_calls\":1,\"units\":2,\"paths\":4}\n") == NULL) {
+        printf("json: last frame wrong:\n%s", text);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+**	With no file open nothing is kept, so frames can be ended safely.
+*/
+int test_disabled(void)
+{
+    TelemetryClass telemetry;
+    Define_Fields(telemetry);
+    Record_Frames(telemetry, 10);
+
+    if (telemetry.Is_Enabled()) {
+        printf("disabled: enabled without a file\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_csv();
+    ret |= test_json();
+    ret |= test_disabled();
+
+    return ret;
+}
@@ -0,0 +1,249 @@
+#include "redalert/think.h"
+#include "common/crc.h"
+#include "common/jobs.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define OBJECTS 300
+#define FRAMES  200
+#define RANGE   40
+
+/*
+**	A line of objects from two sides that look for the most valuable enemy in range
+**	when their timer runs out, then shoot it and step towards it.
+*/
+struct ObjectType
+{
+    int X;
+    int Side;
+    int Strength;
+    int Timer;
+    int Target; // -1 for none
+};
+
+struct WorldType
+{
+    ObjectType Objects[OBJECTS];
+    unsigned Seed;
+    int Scans; // scans made in the act phase
+};
+
+static int Random(WorldType& world, int range)
+{
+    world.Seed = world.Seed * 1103515245 + 12345;
+    return ((world.Seed >> 16) % range);
+}
+
+/*
+**	Only reads the world, like a threat scan.
+*/
+static int Best_Target(WorldType const& world, int index)
+{
+    ObjectType const& self = world.Objects[index];
+    int best = -1;
+    int bestval = 0;
+
+    for (int other = 0; other < OBJECTS; other++) {
+        ObjectType const& obj = world.Objects[other];
+        int dist = obj.X > self.X ? obj.X - self.X : self.X - obj.X;
+        if (obj.Side == self.Side || obj.Strength <= 0 || dist > RANGE) {
+            continue;
+        }
+        int value = obj.Strength * 4 + (RANGE - dist);
+        if (value > bestval) {
+            bestval = value;
+            best = other;
+        }
+    }
+    return (best);
+}
+
+struct CheckType
+{
+    bool operator==(CheckType const& other) const
+    {
+        return (X == other.X && Side == other.Side);
+    }
+
+    int X;
+    int Side;
+};
+
+static CheckType Check_Of(ObjectType const& obj)
+{
+    CheckType check = {obj.X, obj.Side};
+    return (check);
+}
+
+typedef ThinkTableClass<1, CheckType, int> TableType;
+
+struct ThinkType
+{
+    WorldType const* World;
+    int Objects[OBJECTS];
+    int Results[OBJECTS];
+};
+
+static void Think_Range(void* data, int first, int last)
+{
+    ThinkType* think = (ThinkType*)data;
+    for (int index = first; index < last; index++) {
+        think->Results[index] = Best_Target(*think->World, think->Objects[index]);
+    }
+}
+
+static void Init_World(WorldType& world)
+{
+    memset(&world, 0, sizeof(world));
+    world.Seed = 777;
+    for (int index = 0; index < OBJECTS; index++) {
+        ObjectType& obj = world.Objects[index];
+        obj.Side = index & 1;
+        obj.X = Random(world, 1000);
+        obj.Strength = 50 + Random(world, 200);
+        obj.Timer = Random(world, 8);
+        obj.Target = -1;
+    }
+}
+
+/*
+**	Runs the world for a number of frames and returns the CRC of each frame, thinking
+**	ahead on the job system when asked to.
+*/
+static void Run(JobSystemClass& jobs, bool think, int32_t* crcs)
+{
+    static WorldType world;
+    static ThinkType work;
+    TableType table;
+
+    Init_World(world);
+    work.World = &world;
+
+    for (long frame = 0; frame < FRAMES; frame++) {
+        if (think) {
+            int count = 0;
+            for (int index = 0; index < OBJECTS; index++) {
+                if (world.Objects[index].Timer == 0 && world.Objects[index].Strength > 0) {
+                    work.Objects[count++] = index;
+                }
+            }
+            jobs.Parallel_For(0, count, 8, Think_Range, &work);
+            for (int index = 0; index < count; index++) {
+                int id = work.Objects[index];
+                table.Put(0, id, frame, Check_Of(world.Objects[id]), work.Results[index]);
+            }
+        }
+
+        for (int index = 0; index < OBJECTS; index++) {
+            ObjectType& obj = world.Objects[index];
+            if (obj.Strength <= 0) {
+                continue;
+            }
+            if (obj.Timer > 0) {
+                obj.Timer--;
+                continue;
+            }
+
+            /*
+            **	A thought is only taken if the object hasn't moved since, and what it found
+            **	is still alive; otherwise the scan is made again.
+            */
+            int target = -1;
+            if (!think || !table.Take(0, index, frame, Check_Of(obj), target)
+                || (target != -1 && world.Objects[target].Strength <= 0)) {
+                target = Best_Target(world, index);
+                world.Scans++;
+            }
+
+            obj.Target = target;
+            if (target != -1) {
+                world.Objects[target].Strength -= 5 + Random(world, 20);
+                obj.X += world.Objects[target].X > obj.X ? 1 : -1;
+            } else {
+                obj.X += Random(world, 3) - 1;
+            }
+            obj.Timer = 2 + Random(world, 6);
+        }
+
+        crcs[frame] = Calculate_CRC(world.Objects, sizeof(world.Objects)) ^ (int32_t)world.Seed;
+    }
+}
+
+/*
+**	The think phase must come out the same whether the scans are made on one thread or
+**	spread over a pool, frame after frame, like the game CRC in a lockstep game.
+*/
+int test_crc(void)
+{
+    static int32_t serial[FRAMES];
+    static int32_t pooled[FRAMES];
+    static const int workers[] = {0, 1, 3, 7};
+
+    for (unsigned w = 0; w < sizeof(workers) / sizeof(workers[0]); w++) {
+        JobSystemClass jobs(workers[w], 16 * 1024);
+
+        jobs.Set_Serial(true);
+        Run(jobs, true, serial);
+        jobs.Set_Serial(false);
+        Run(jobs, true, pooled);
+
+        for (int frame = 0; frame < FRAMES; frame++) {
+            if (serial[frame] != pooled[frame]) {
+                printf("crc: %d workers differ from serial at frame %d\n", workers[w], frame);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+**	A thought is handed out once, in its own frame, to an object whose inputs still match.
+*/
+int test_take(void)
+{
+    TableType table;
+    CheckType check = {10, 1};
+    CheckType moved = {11, 1};
+    int result = 0;
+
+    if (table.Take(0, 3, 0, check, result)) {
+        printf("take: an empty table handed out a result\n");
+        return 1;
+    }
+
+    table.Put(0, 3, 5, check, 42);
+    if (table.Take(0, 3, 6, check, result) || table.Take(0, 3, 5, moved, result) || table.Take(0, 4, 5, check, result)) {
+        printf("take: a stale or mismatched result was handed out\n");
+        return 1;
+    }
+    if (!table.Take(0, 3, 5, check, result) || result != 42) {
+        printf("take: a matching result was not handed out\n");
+        return 1;
+    }
+    if (table.Take(0, 3, 5, check, result)) {
+        printf("take: a result was handed out twice\n");
+        return 1;
+    }
+
+    table.Put(1, 0, 5, check, 1);
+    table.Put(-1, 0, 5, check, 1);
+    if (table.Take(1, 0, 5, check, result)) {
+        printf("take: an out of range kind was kept\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_take();
+    ret |= test_crc();
+
+    return ret;
+}
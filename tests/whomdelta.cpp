@@ -0,0 +1,211 @@
+#include "redalert/whomdelta.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+**	Stores a run of 'Whom's as a compressed MegaMission does: the count byte, the first
+**	value verbatim, then the rest as deltas or verbatim depending on the flag.
+*/
+static int Put_Run(unsigned char* buf, long const* whoms, int count, bool delta)
+{
+    int pos = 0;
+
+    buf[pos++] = (unsigned char)(count | (delta ? MEGAMISSION_DELTA : 0));
+    memcpy(buf + pos, &whoms[0], sizeof(whoms[0]));
+    pos += sizeof(whoms[0]);
+    for (int i = 1; i < count; i++) {
+        pos += Encode_Whom(buf + pos, whoms[i - 1], whoms[i], delta);
+    }
+
+    return (pos);
+}
+
+/*
+**	Reads back a run stored by Put_Run. Returns the number of bytes used, or zero if
+**	the buffer ran out.
+*/
+static int Get_Run(unsigned char const* buf, int bufsize, long* whoms, int* count)
+{
+    int pos = 0;
+
+    if (bufsize < 1 + (int)sizeof(whoms[0])) {
+        return (0);
+    }
+    bool delta = (buf[pos] & MEGAMISSION_DELTA) != 0;
+    *count = buf[pos++] & MEGAMISSION_RUN_MAX;
+    memcpy(&whoms[0], buf + pos, sizeof(whoms[0]));
+    pos += sizeof(whoms[0]);
+    for (int i = 1; i < *count; i++) {
+        int size = Decode_Whom(buf + pos, bufsize - pos, whoms[i - 1], whoms[i], delta);
+        if (size == 0) {
+            return (0);
+        }
+        pos += size;
+    }
+
+    return (pos);
+}
+
+/*
+**	Each pair must come back exactly, in the number of bytes the encoder said it used,
+**	and the size-only pass must agree with the real one.
+*/
+int test_pairs(void)
+{
+    static const long pairs[][2] = {{0, 0},
+                                    {100, 101},
+                                    {101, 100},
+                                    {5000, 4000},
+                                    {0, 63},
+                                    {0, -64},
+                                    {0, 64},
+                                    {0, -65},
+                                    {0, 0x7FFFFFFF},
+                                    {0x7FFFFFFF, 0},
+                                    {LONG_MIN, LONG_MAX},
+                                    {LONG_MAX, LONG_MIN},
+                                    {-1, LONG_MAX},
+                                    {LONG_MIN, 0}};
+    unsigned char buf[16];
+
+    for (unsigned i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        long whom = 0;
+        int size = Encode_Whom_Delta(buf, pairs[i][0], pairs[i][1]);
+
+        if (size != Encode_Whom_Delta(NULL, pairs[i][0], pairs[i][1])) {
+            printf("pairs: size-only pass disagrees for pair %u\n", i);
+            return 1;
+        }
+        if (Decode_Whom_Delta(buf, size, pairs[i][0], whom) != size || whom != pairs[i][1]) {
+            printf("pairs: pair %u came back as %ld\n", i, whom);
+            return 1;
+        }
+        if (Decode_Whom_Delta(buf, size - 1, pairs[i][0], whom) != 0) {
+            printf("pairs: truncated pair %u was accepted\n", i);
+            return 1;
+        }
+    }
+
+    /*
+    **	Deltas that fit in 7 bits once zigzagged take one byte, either way.
+    */
+    if (Encode_Whom_Delta(NULL, 1000, 1063) != 1 || Encode_Whom_Delta(NULL, 1000, 936) != 1
+        || Encode_Whom_Delta(NULL, 1000, 1064) != 2 || Encode_Whom_Delta(NULL, 1000, 935) != 2) {
+        printf("pairs: small deltas are not one byte\n");
+        return 1;
+    }
+
+    /*
+    **	A run of continuation bytes longer than a long can hold is refused.
+    */
+    memset(buf, 0xFF, sizeof(buf));
+    long whom = 0;
+    if (Decode_Whom_Delta(buf, sizeof(buf), 0, whom) != 0) {
+        printf("pairs: overlong delta was accepted\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+**	Full length runs, wandering up and down by small and large steps, must come back
+**	whole whether they're stored as deltas or verbatim, and a short buffer must be
+**	caught anywhere in the run.
+*/
+int test_runs(void)
+{
+    long whoms[MEGAMISSION_RUN_MAX];
+    long back[MEGAMISSION_RUN_MAX];
+    unsigned char buf[1 + MEGAMISSION_RUN_MAX * sizeof(long)];
+    unsigned seed = 12345;
+
+    whoms[0] = 0x10000100;
+    for (int i = 1; i < MEGAMISSION_RUN_MAX; i++) {
+        seed = seed * 1103515245 + 12345;
+        long step = (seed >> 16) & 0xFF;
+        if (i % 11 == 0) {
+            step <<= 20;
+        }
+        whoms[i] = (seed & 0x8000) ? whoms[i - 1] - step : whoms[i - 1] + step;
+    }
+
+    for (int delta = 0; delta < 2; delta++) {
+        int size = Put_Run(buf, whoms, MEGAMISSION_RUN_MAX, delta != 0);
+        int count = 0;
+
+        memset(back, 0, sizeof(back));
+        if (Get_Run(buf, size, back, &count) != size || count != MEGAMISSION_RUN_MAX
+            || memcmp(back, whoms, sizeof(whoms)) != 0) {
+            printf("runs: run with delta %d did not come back\n", delta);
+            return 1;
+        }
+        if (delta && size >= 1 + MEGAMISSION_RUN_MAX * (int)sizeof(long)) {
+            printf("runs: delta run is no smaller than verbatim\n");
+            return 1;
+        }
+        for (int cut = 0; cut < size; cut++) {
+            if (Get_Run(buf, cut, back, &count) != 0) {
+                printf("runs: run with delta %d cut at %d was accepted\n", delta, cut);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+**	Runs of both kinds packed back to back, as a packet from a peer mixing them would be,
+**	must each be read by their own count byte.
+*/
+int test_mixed(void)
+{
+    static const long run1[] = {0x2000040, 0x2000041, 0x2000043, 0x200003F};
+    static const long run2[] = {0x2000080, 0x1000000, 0x3000000};
+    static const long run3[] = {0x40000010, -0x40000010, 0x40000010, 0x40000011, 0x40000012};
+    static const long run4[] = {0x1234};
+    static const struct {
+        long const* Whoms;
+        int Count;
+        bool Delta;
+    } runs[] = {{run1, 4, true}, {run2, 3, false}, {run3, 5, true}, {run4, 1, true}, {run1, 4, false}};
+    unsigned char buf[256];
+    int size = 0;
+
+    for (unsigned i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        size += Put_Run(buf + size, runs[i].Whoms, runs[i].Count, runs[i].Delta);
+    }
+
+    int pos = 0;
+    for (unsigned i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        long back[8];
+        int count = 0;
+        int used = Get_Run(buf + pos, size - pos, back, &count);
+
+        if (used == 0 || count != runs[i].Count || memcmp(back, runs[i].Whoms, count * sizeof(long)) != 0) {
+            printf("mixed: run %u did not come back\n", i);
+            return 1;
+        }
+        pos += used;
+    }
+    if (pos != size) {
+        printf("mixed: read %d bytes of %d\n", pos, size);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_pairs();
+    ret |= test_runs();
+    ret |= test_mixed();
+
+    return ret;
+}
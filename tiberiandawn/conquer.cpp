@@ -64,6 +64,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include "common/framearena.h"
 #include "common/framelimit.h"
 #include "common/vqatask.h"
 #include "common/vqaloader.h"
@@ -1666,6 +1667,11 @@ bool Main_Loop()
         }
     }
 
+    /*
+    **	Anything allocated from the frame arena during this frame is released.
+    */
+    FrameArenaClass::Thread().Reset();
+
     Sync_Delay();
     //	InMainLoop = false;
     return (!GameActive);
@@ -41,6 +41,7 @@
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
+#include <limits.h>
 
 /***************************************************************************
  * NonSequencedConnClass::NonSequencedConnClass -- class constructor       *
@@ -124,8 +125,8 @@ void NonSequencedConnClass::Init(void)
     NumSendNoAck = 0;
     NumSendAck = 0;
 
-    LastSeqID = 0xffffffff;
-    LastReadID = 0xffffffff;
+    LastSeqID = ULONG_MAX;
+    LastReadID = ULONG_MAX;
 
     Queue->Init();
 }
@@ -300,7 +301,7 @@ int NonSequencedConnClass::Receive_Packet(void* buf, int buflen)
         If this is a packet requires an ACK, and it's ID is older than our
         "oldest" ID, we know it's a resend; send an ACK, but don't queue it
         ....................................................................*/
-        if (packet->PacketID <= LastSeqID && LastSeqID != 0xffffffff) {
+        if (packet->PacketID <= LastSeqID && LastSeqID != ULONG_MAX) {
             // Smart_Printf( "Older than oldest\n" );
             save_packet = 0;
         }